@@ -0,0 +1,19 @@
+#include "BenchmarkUtils.h"
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+volatile double BenchmarkUtils::sink = 0.0;
+
+double BenchmarkUtils::time_it(string const& text, int repeat_count, function<void ()> f)
+{
+	f(); // warm up
+	auto start = chrono::steady_clock::now();
+	for (int i = 0; i < repeat_count; i++)
+		f();
+	auto stop = chrono::steady_clock::now();
+	auto ms = chrono::duration<double, milli>(stop - start).count() / repeat_count;
+	cout << text << " " << ms << endl;
+	return ms;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+// Benchmarks are only meaningful in an optimized build (e.g. CMAKE_BUILD_TYPE=Release)
+class BenchmarkUtils
+{
+public:
+	//prints the average wall clock milliseconds per call of f
+	static double time_it(std::string const& text, int repeat_count, std::function<void ()> f);
+
+	//keeps the optimizer from discarding a computed result
+	template <typename T>
+	static void consume(T const& value)
+	{
+		sink = sink + static_cast<double>(value);
+	}
+
+private:
+	static volatile double sink;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+void run_push_benchmarks();
+void run_thread_pool_benchmarks();
+void run_parallel_benchmarks();
+void run_order_by_benchmarks();
+void run_merge_benchmarks();
+
+void run_group_by_benchmarks();
+void run_join_benchmarks();
+void run_distinct_benchmarks();
+void run_reduce_benchmarks();
+void run_where_benchmarks();
+void run_capture_benchmarks();
+void run_memory_benchmarks();
+void run_memoize_benchmarks();
\ No newline at end of file
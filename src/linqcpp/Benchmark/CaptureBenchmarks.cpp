@@ -0,0 +1,98 @@
+#include <linqcpp/linq/interactive.h>
+#include "BenchmarkUtils.h"
+#include "Benchmarks.h"
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+// The cost of type erasure
+// o The size of a deep pipeline's enumerator, and a pull loop over it, statically typed and captured
+// o sum over the same pipeline, which is batched through the captured enumerator's virtual next_batch
+// o select_many over 1M small inner sequences, each captured, against a plain loop
+void run_capture_benchmarks()
+{
+	const int repeat_count = 10;
+	vector<int> values(10000000);
+	for (size_t i = 0; i < values.size(); i++)
+		values[i] = static_cast<int>(i % 1000);
+
+	auto pipeline = [&]()
+	{
+		return linq::from(values)
+			.where([](int n){ return n % 3 != 0; })
+			.select([](int n){ return n * 2; })
+			.where([](int n){ return n % 5 != 0; })
+			.select([](int n){ return static_cast<long long>(n) + 1; });
+	};
+
+	cout << "pipeline enumerator bytes " << sizeof(pipeline().get_enumerator()) << endl;
+
+	BenchmarkUtils::time_it("pipeline pull static", repeat_count, [&]()
+	{
+		auto q = pipeline();
+		auto e = q.get_enumerator();
+		long long sum = 0;
+		if (e.move_first())
+		{
+			do
+			{
+				sum += e.current();
+			} while (e.move_next());
+		}
+		BenchmarkUtils::consume(sum);
+	});
+
+	BenchmarkUtils::time_it("pipeline pull captured", repeat_count, [&]()
+	{
+		auto q = pipeline().capture();
+		auto e = q.get_enumerator();
+		long long sum = 0;
+		if (e.move_first())
+		{
+			do
+			{
+				sum += e.current();
+			} while (e.move_next());
+		}
+		BenchmarkUtils::consume(sum);
+	});
+
+	vector<vector<int>> nested(1000000);
+	for (size_t i = 0; i < nested.size(); i++)
+		nested[i].assign(i % 5, static_cast<int>(i));
+
+	BenchmarkUtils::time_it("pipeline sum static", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(pipeline().sum());
+	});
+
+	BenchmarkUtils::time_it("pipeline sum captured", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(pipeline().capture().sum());
+	});
+
+	BenchmarkUtils::time_it("loop", repeat_count, [&]()
+	{
+		size_t count = 0;
+		for (auto inner = nested.begin(); inner != nested.end(); ++inner)
+			count += inner->size();
+		BenchmarkUtils::consume(count);
+	});
+
+	BenchmarkUtils::time_it("select_many captured", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(nested)
+			.select_many([](vector<int> const& inner){ return linq::from(inner).capture(); })
+			.count());
+	});
+
+	BenchmarkUtils::time_it("select_many captured select", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(nested)
+			.select_many([](vector<int> const& inner){ return linq::from(inner).select([](int x){ return static_cast<long long>(x); }).capture(); })
+			.sum());
+	});
+}
\ No newline at end of file
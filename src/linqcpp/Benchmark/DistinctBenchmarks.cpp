@@ -0,0 +1,63 @@
+#include <linqcpp/linq/interactive.h>
+#include "BenchmarkUtils.h"
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <set>
+#include <unordered_set>
+#include <vector>
+
+using namespace std;
+
+// Deduplicating 10M event ids (about 5M distinct): std::set and std::unordered_set against distinct,
+// and distinct_sorted over the ids in sorted order
+void run_distinct_benchmarks()
+{
+	const int repeat_count = 2;
+	vector<long long> ids(10000000);
+	unsigned long long state = 88172645463325252ULL;
+	for (size_t i = 0; i < ids.size(); i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		ids[i] = static_cast<long long>(state % 8000000);
+	}
+	vector<long long> sorted_ids(ids);
+	sort(sorted_ids.begin(), sorted_ids.end());
+
+	BenchmarkUtils::time_it("std::set", repeat_count, [&]()
+	{
+		set<long long> seen;
+		long long total = 0;
+		for (auto id = ids.begin(); id != ids.end(); ++id)
+		{
+			if (seen.insert(*id).second)
+				total += *id;
+		}
+		BenchmarkUtils::consume(total);
+	});
+
+	BenchmarkUtils::time_it("std::unordered_set", repeat_count, [&]()
+	{
+		unordered_set<long long> seen;
+		long long total = 0;
+		for (auto id = ids.begin(); id != ids.end(); ++id)
+		{
+			if (seen.insert(*id).second)
+				total += *id;
+		}
+		BenchmarkUtils::consume(total);
+	});
+
+	BenchmarkUtils::time_it("distinct", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(ids).distinct().sum());
+	});
+
+	BenchmarkUtils::time_it("distinct_sorted", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(sorted_ids).distinct_sorted().sum());
+	});
+}
\ No newline at end of file
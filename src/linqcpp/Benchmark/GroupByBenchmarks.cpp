@@ -0,0 +1,71 @@
+#include <linqcpp/linq/interactive.h>
+#include "BenchmarkUtils.h"
+#include "Benchmarks.h"
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// group_by and to_lookup over 4M random values in 10k groups, against a std::map<key, vector<value>>,
+// and group_by with 100k string keys
+void run_group_by_benchmarks()
+{
+	const int repeat_count = 3;
+	vector<long long> values(4000000);
+	vector<string> names(1000000);
+	unsigned long long state = 88172645463325252ULL;
+	for (size_t i = 0; i < values.size(); i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		values[i] = static_cast<long long>(state >> 24);
+		if (i < names.size())
+			names[i] = "customer-" + to_string(state % 100000);
+	}
+
+	BenchmarkUtils::time_it("std::map<key, vector> 10k groups", repeat_count, [&]()
+	{
+		map<long long, vector<long long>> groups;
+		for (auto value = values.begin(); value != values.end(); ++value)
+			groups[*value % 10000].push_back(*value);
+		long long total = 0;
+		for (auto group = groups.begin(); group != groups.end(); ++group)
+			total += group->first * static_cast<long long>(group->second.size());
+		BenchmarkUtils::consume(total);
+	});
+
+	BenchmarkUtils::time_it("group_by 10k groups", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(values)
+			.group_by([](long long n){ return n % 10000; })
+			.aggregate(0LL, [](long long total, linq::grouping<long long, long long> const& group){ return total + group.key() * static_cast<long long>(group.size()); }));
+	});
+
+	BenchmarkUtils::time_it("to_lookup 10k groups, 10k lookups", repeat_count, [&]()
+	{
+		auto groups = linq::from(values).to_lookup([](long long n){ return n % 10000; });
+		size_t total = 0;
+		for (long long key = 0; key < 10000; key++)
+			total += groups[key].size();
+		BenchmarkUtils::consume(total);
+	});
+
+	BenchmarkUtils::time_it("std::map<string, vector> 100k groups", repeat_count, [&]()
+	{
+		map<string, vector<string>> groups;
+		for (auto name = names.begin(); name != names.end(); ++name)
+			groups[*name].push_back(*name);
+		BenchmarkUtils::consume(groups.size());
+	});
+
+	BenchmarkUtils::time_it("group_by 100k string groups", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(names)
+			.group_by([](string const& name){ return name; })
+			.aggregate(size_t(0), [](size_t total, linq::grouping<string, string> const&){ return total + 1; }));
+	});
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include <linqcpp/linq/interactive.h>
+#include "BenchmarkUtils.h"
+#include "Benchmarks.h"
+
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+	struct order
+	{
+		long long customer;
+		long long amount;
+	};
+
+	struct customer
+	{
+		long long id;
+		long long region;
+	};
+
+}
+
+// Correlating orders with their customers: nested where/any against join, both ways round, and group_join
+void run_join_benchmarks()
+{
+	const int repeat_count = 3;
+	vector<order> orders(4000000);
+	vector<customer> customers(100000);
+	unsigned long long state = 88172645463325252ULL;
+	for (size_t i = 0; i < orders.size(); i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		orders[i].customer = static_cast<long long>(state % 200000);
+		orders[i].amount = static_cast<long long>(state >> 48);
+	}
+	for (size_t i = 0; i < customers.size(); i++)
+	{
+		customers[i].id = static_cast<long long>(2 * i);
+		customers[i].region = static_cast<long long>(i % 16);
+	}
+	vector<order> few_orders(orders.begin(), orders.begin() + 20000);
+	vector<customer> few_customers(customers.begin(), customers.begin() + 5000);
+
+	BenchmarkUtils::time_it("nested where/any 20k orders x 5k customers", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(few_orders)
+			.where([&](order const& o){ return linq::from(few_customers).any([&](customer const& c){ return c.id == o.customer; }); })
+			.aggregate(0LL, [](long long total, order const& o){ return total + o.amount; }));
+	});
+
+	BenchmarkUtils::time_it("join 20k orders x 5k customers", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(few_orders)
+			.join(linq::from(few_customers), [](order const& o){ return o.customer; }, [](customer const& c){ return c.id; },
+				[](order const& o, customer const&){ return o.amount; })
+			.sum());
+	});
+
+	BenchmarkUtils::time_it("join 4M orders x 100k customers (customers built)", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(orders)
+			.join(linq::from(customers), [](order const& o){ return o.customer; }, [](customer const& c){ return c.id; },
+				[](order const& o, customer const& c){ return o.amount * c.region; })
+			.sum());
+	});
+
+	BenchmarkUtils::time_it("join 100k customers x 4M orders (customers built)", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(customers)
+			.join(linq::from(orders), [](customer const& c){ return c.id; }, [](order const& o){ return o.customer; },
+				[](customer const& c, order const& o){ return o.amount * c.region; })
+			.build_smaller_side()
+			.sum());
+	});
+
+	BenchmarkUtils::time_it("group_join 100k customers x 4M orders", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(customers)
+			.group_join(linq::from(orders), [](customer const& c){ return c.id; }, [](order const& o){ return o.customer; },
+				[](customer const&, linq::grouping<long long, order> const& orders){ return static_cast<long long>(orders.size()); })
+			.sum());
+	});
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include <linqcpp/linq/interactive.h>
+#include "BenchmarkUtils.h"
+#include "Benchmarks.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// A parsed source enumerated three times (sum, matches, minmax): re-parsed every time, or parsed once by memoize_all
+void run_memoize_benchmarks()
+{
+	const int repeat_count = 10;
+	vector<string> lines(1000000);
+	for (size_t i = 0; i < lines.size(); i++)
+	{
+		ostringstream line;
+		line << (i * 2654435761u) % 100000 << "." << i % 100;
+		lines[i] = line.str();
+	}
+
+	auto parsed = [&]()
+	{
+		return linq::from(lines).select([](string const& line){ return strtod(line.c_str(), nullptr); });
+	};
+
+	BenchmarkUtils::time_it("three passes re-parsed", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(parsed().sum());
+		size_t matches = 0;
+		parsed().for_each([&](double x){ matches += x > 50000; });
+		BenchmarkUtils::consume(matches);
+		BenchmarkUtils::consume(parsed().minmax().second);
+	});
+
+	BenchmarkUtils::time_it("three passes memoize_all", repeat_count, [&]()
+	{
+		auto values = parsed().memoize_all();
+		BenchmarkUtils::consume(values.sum());
+		size_t matches = 0;
+		values.for_each([&](double x){ matches += x > 50000; });
+		BenchmarkUtils::consume(matches);
+		BenchmarkUtils::consume(values.select([](double x){ return x; }).minmax().second);
+	});
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include <linqcpp/linq/interactive.h>
+#include "BenchmarkUtils.h"
+#include "Benchmarks.h"
+
+#include <cstddef>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Request-per-query servers: every thread runs small buffering queries (order_by, group_by, distinct, join, to_vector),
+// with their buffers on the global heap or in a per-request monotonic_buffer_resource released after each query
+namespace {
+
+	struct order
+	{
+		int customer;
+		int item;
+		double price;
+	};
+
+	double run_request(vector<order>& orders, vector<int>& customers, linq::memory_resource* arena)
+	{
+		double result = 0;
+		if (arena)
+		{
+			result += linq::from(orders).order_by([](order const& o){ return o.price; }).buffer_in(*arena)
+				.take(100).select([](order const& o){ return o.price; }).sum();
+			result += linq::from(orders).group_by([](order const& o){ return o.customer; }).buffer_in(*arena).count();
+			result += linq::from(orders).distinct_by([](order const& o){ return o.item; }).buffer_in(*arena).count();
+			result += linq::from(customers).join(linq::from(orders), [](int c){ return c; }, [](order const& o){ return o.customer; },
+				[](int, order const& o){ return o.price; }).buffer_in(*arena).sum();
+			result += linq::from(orders).select([](order const& o){ return o.item; }).to_vector(linq::resource_allocator<int>(arena)).size();
+		}
+		else
+		{
+			result += linq::from(orders).order_by([](order const& o){ return o.price; })
+				.take(100).select([](order const& o){ return o.price; }).sum();
+			result += linq::from(orders).group_by([](order const& o){ return o.customer; }).count();
+			result += linq::from(orders).distinct_by([](order const& o){ return o.item; }).count();
+			result += linq::from(customers).join(linq::from(orders), [](int c){ return c; }, [](order const& o){ return o.customer; },
+				[](int, order const& o){ return o.price; }).sum();
+			result += linq::from(orders).select([](order const& o){ return o.item; }).to_vector().size();
+		}
+		return result;
+	}
+
+	void run_requests(size_t thread_count, size_t request_count, bool use_arena, vector<order>& orders, vector<int>& customers)
+	{
+		vector<thread> threads;
+		for (size_t t = 0; t < thread_count; ++t)
+		{
+			threads.push_back(thread([&]()
+			{
+				linq::monotonic_buffer_resource arena;
+				double result = 0;
+				for (size_t r = 0; r < request_count; ++r)
+				{
+					result += run_request(orders, customers, use_arena ? &arena : nullptr);
+					arena.release();
+				}
+				BenchmarkUtils::consume(result);
+			}));
+		}
+		for (auto t = threads.begin(); t != threads.end(); ++t)
+			t->join();
+	}
+
+}
+
+void run_memory_benchmarks()
+{
+	const int repeat_count = 5;
+	const size_t request_count = 200;
+	vector<order> orders(5000);
+	for (size_t i = 0; i < orders.size(); i++)
+	{
+		orders[i].customer = static_cast<int>((i * 7919) % 700);
+		orders[i].item = static_cast<int>((i * 104729) % 1500);
+		orders[i].price = static_cast<double>((i * 2654435761u) % 100000) / 100.0;
+	}
+	vector<int> customers;
+	for (int c = 0; c < 700; c += 7)
+		customers.push_back(c);
+
+	vector<size_t> thread_counts;
+	size_t hardware = thread::hardware_concurrency();
+	for (size_t n = 1; n < hardware; n *= 2)
+		thread_counts.push_back(n);
+	thread_counts.push_back(hardware == 0 ? 1 : hardware);
+
+	for (auto threads = thread_counts.begin(); threads != thread_counts.end(); ++threads)
+	{
+		ostringstream suffix;
+		suffix << " threads=" << *threads;
+
+		BenchmarkUtils::time_it("requests global heap" + suffix.str(), repeat_count, [&]()
+		{
+			run_requests(*threads, request_count, false, orders, customers);
+		});
+
+		BenchmarkUtils::time_it("requests arena      " + suffix.str(), repeat_count, [&]()
+		{
+			run_requests(*threads, request_count, true, orders, customers);
+		});
+	}
+}
\ No newline at end of file
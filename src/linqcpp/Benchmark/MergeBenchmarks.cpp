@@ -0,0 +1,53 @@
+#include <linqcpp/linq/interactive.h>
+#include "BenchmarkUtils.h"
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+// merge_all over 64 sorted shards of 4M values in total, against ordering their concatenation
+void run_merge_benchmarks()
+{
+	const int repeat_count = 3;
+	const size_t shard_count = 64;
+	vector<vector<long long>> shards(shard_count);
+	vector<long long> all;
+	unsigned long long state = 88172645463325252ULL;
+	for (size_t i = 0; i < 4000000; i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		long long value = static_cast<long long>(state >> 24);
+		shards[state % shard_count].push_back(value);
+		all.push_back(value);
+	}
+	for (auto shard = shards.begin(); shard != shards.end(); ++shard)
+		sort(shard->begin(), shard->end());
+
+	BenchmarkUtils::time_it("merge_all 64 shards", repeat_count, [&]()
+	{
+		vector<decltype(linq::from(shards[0]))> sources;
+		for (auto shard = shards.begin(); shard != shards.end(); ++shard)
+			sources.push_back(linq::from(*shard));
+		BenchmarkUtils::consume(linq::merge_all(sources).sum());
+	});
+
+	BenchmarkUtils::time_it("merge_all 64 shards with key selector", repeat_count, [&]()
+	{
+		vector<decltype(linq::from(shards[0]))> sources;
+		for (auto shard = shards.begin(); shard != shards.end(); ++shard)
+			sources.push_back(linq::from(*shard));
+		BenchmarkUtils::consume(linq::merge_all(sources, [](long long n){ return n >> 8; }).sum());
+	});
+
+	BenchmarkUtils::time_it("order_by of the concatenated shards", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(all)
+			.order_by([](long long n){ return n; })
+			.sum());
+	});
+}
\ No newline at end of file
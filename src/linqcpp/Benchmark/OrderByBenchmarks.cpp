@@ -0,0 +1,172 @@
+#include <linqcpp/linq/interactive.h>
+#include "BenchmarkUtils.h"
+#include "Benchmarks.h"
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+	vector<size_t> benchmark_worker_counts()
+	{
+		vector<size_t> worker_counts;
+		size_t hardware = thread::hardware_concurrency();
+		for (size_t n = 1; n < 8 && n < hardware; n *= 2)
+			worker_counts.push_back(n);
+		if (hardware > 8)
+			worker_counts.push_back(8);
+		worker_counts.push_back(hardware == 0 ? 1 : hardware);
+		return worker_counts;
+	}
+
+}
+
+// order_by over 10M random keys
+// o sequentially (radix sorted, since the keys are arithmetic), as a top-k / page window, and with parallel_sort on 1, 2, 4, 8 and all workers
+void run_order_by_benchmarks()
+{
+	const int repeat_count = 2;
+	vector<long long> values(10000000);
+	unsigned long long state = 88172645463325252ULL;
+	for (size_t i = 0; i < values.size(); i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		values[i] = static_cast<long long>(state >> 24);
+	}
+
+	BenchmarkUtils::time_it("order_by sequential", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(values)
+			.order_by([](long long n){ return n; })
+			.sum());
+	});
+
+	BenchmarkUtils::time_it("order_by double keys", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(values)
+			.order_by([](long long n){ return static_cast<double>(n) * -0.5; })
+			.sum());
+	});
+
+	BenchmarkUtils::time_it("order_by.then_by pair keys", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(values)
+			.order_by([](long long n){ return static_cast<int>(n & 0xff); })
+			.then_by([](long long n){ return n; })
+			.sum());
+	});
+
+	BenchmarkUtils::time_it("order_by memory_budget 16MB (spilled runs)", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(values)
+			.order_by([](long long n){ return n; })
+			.memory_budget(16 << 20)
+			.sum());
+	});
+
+	//"last name then first name": string keys, selected once per value rather than per comparison
+	vector<pair<string, string>> names(1000000);
+	for (size_t i = 0; i < names.size(); i++)
+	{
+		names[i].first = "last" + to_string(values[i] % 5000);
+		names[i].second = "first" + to_string((values[i] >> 16) % 500);
+	}
+
+	BenchmarkUtils::time_it("order_by.then_by string keys (1M)", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(names)
+			.order_by([](pair<string, string> const& name){ return name.first; })
+			.then_by([](pair<string, string> const& name){ return name.second; })
+			.aggregate(static_cast<size_t>(0), [](size_t n, pair<string, string> const& name){ return n + name.second.size(); }));
+	});
+
+	//a 4 level report sort, level by level and as one normalized (memcmp) key
+	BenchmarkUtils::time_it("order_by 4 levels (1M)", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(names)
+			.order_by([](pair<string, string> const& name){ return name.first.size(); })
+			.then_by([](pair<string, string> const& name){ return name.first; })
+			.then_by_descending([](pair<string, string> const& name){ return name.second.size(); })
+			.then_by([](pair<string, string> const& name){ return name.second; })
+			.aggregate(static_cast<size_t>(0), [](size_t n, pair<string, string> const& name){ return n + name.second.size(); }));
+	});
+
+	BenchmarkUtils::time_it("order_by 4 levels normalized_keys (1M)", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(names)
+			.order_by([](pair<string, string> const& name){ return name.first.size(); })
+			.then_by([](pair<string, string> const& name){ return name.first; })
+			.then_by_descending([](pair<string, string> const& name){ return name.second.size(); })
+			.then_by([](pair<string, string> const& name){ return name.second; })
+			.normalized_keys()
+			.aggregate(static_cast<size_t>(0), [](size_t n, pair<string, string> const& name){ return n + name.second.size(); }));
+	});
+
+	//an appended time series with a few late arrivals: natural runs are merged instead of sorted again
+	vector<pair<string, long long>> events(1000000);
+	for (size_t i = 0; i < events.size(); i++)
+	{
+		long long time = static_cast<long long>(i) * 10;
+		if (values[i] % 100 == 0)
+			time -= values[i] % 5000;
+		events[i] = make_pair(to_string(time), time);
+	}
+
+	BenchmarkUtils::time_it("order_by nearly sorted string keys (1M)", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(events)
+			.order_by([](pair<string, long long> const& e){ return e.second; })
+			.then_by([](pair<string, long long> const& e){ return e.first; })
+			.aggregate(static_cast<long long>(0), [](long long n, pair<string, long long> const& e){ return n ^ e.second; }));
+	});
+
+	BenchmarkUtils::time_it("order_by.take(10) top-k heap", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(values)
+			.order_by([](long long n){ return n; })
+			.take(10)
+			.sum());
+	});
+
+	BenchmarkUtils::time_it("order_by.skip(5000).take(50) page window", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(values)
+			.order_by([](long long n){ return n; })
+			.skip(5000)
+			.take(50)
+			.sum());
+	});
+
+	//only the window is ordered: the million values before it are split off by nth_element, not sorted
+	BenchmarkUtils::time_it("order_by.skip(1000000).take(10) deep page window", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(values)
+			.order_by([](long long n){ return n; })
+			.skip(1000000)
+			.take(10)
+			.sum());
+	});
+
+	vector<size_t> worker_counts = benchmark_worker_counts();
+	for (auto workers = worker_counts.begin(); workers != worker_counts.end(); ++workers)
+	{
+		linq::thread_pool pool(*workers);
+		ostringstream name;
+		name << "order_by parallel_sort workers=" << *workers;
+		BenchmarkUtils::time_it(name.str(), repeat_count, [&]()
+		{
+			BenchmarkUtils::consume(linq::from(values)
+				.order_by([](long long n){ return n; })
+				.parallel_sort(pool)
+				.sum());
+		});
+	}
+}
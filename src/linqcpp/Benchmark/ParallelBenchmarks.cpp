@@ -0,0 +1,67 @@
+#include <linqcpp/linq/interactive.h>
+#include "BenchmarkUtils.h"
+#include "Benchmarks.h"
+
+#include <cstddef>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Sequential reductions against parallel() on pools of 1, 2, 4, ... hardware workers
+void run_parallel_benchmarks()
+{
+	const int repeat_count = 10;
+	vector<double> values(1 << 24);
+	for (size_t i = 0; i < values.size(); i++)
+		values[i] = static_cast<double>((i * 2654435761u) % 100000) / 100.0;
+
+	BenchmarkUtils::time_it("sum         sequential", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(values).sum());
+	});
+
+	BenchmarkUtils::time_it("select.sum  sequential", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(values).select([](double x){ return x * x; }).sum());
+	});
+
+	BenchmarkUtils::time_it("minmax      sequential", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(values).select([](double x){ return x; }).minmax().second);
+	});
+
+	vector<size_t> worker_counts;
+	size_t hardware = thread::hardware_concurrency();
+	for (size_t n = 1; n < hardware; n *= 2)
+		worker_counts.push_back(n);
+	worker_counts.push_back(hardware == 0 ? 1 : hardware);
+
+	for (auto workers = worker_counts.begin(); workers != worker_counts.end(); ++workers)
+	{
+		linq::thread_pool pool(*workers);
+		ostringstream suffix;
+		suffix << " workers=" << *workers;
+
+		BenchmarkUtils::time_it("sum         parallel" + suffix.str(), repeat_count, [&]()
+		{
+			BenchmarkUtils::consume(linq::from(values).parallel(pool).sum());
+		});
+
+		BenchmarkUtils::time_it("select.sum  parallel" + suffix.str(), repeat_count, [&]()
+		{
+			BenchmarkUtils::consume(linq::from(values).select([](double x){ return x * x; }).parallel(pool).sum());
+		});
+
+		BenchmarkUtils::time_it("minmax      parallel" + suffix.str(), repeat_count, [&]()
+		{
+			BenchmarkUtils::consume(linq::from(values).parallel(pool).minmax().second);
+		});
+
+		BenchmarkUtils::time_it("count_if    parallel" + suffix.str(), repeat_count, [&]()
+		{
+			BenchmarkUtils::consume(linq::from(values).parallel(pool).count_if([](double x){ return x > 500.0; }));
+		});
+	}
+}
@@ -0,0 +1,137 @@
+#include <linqcpp/linq/interactive.h>
+#include "BenchmarkUtils.h"
+#include "Benchmarks.h"
+
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+// Compares the ways a terminal operator can drive a from(vector) pipeline
+// o pull: move_first/move_next/current through every adaptor
+// o push: a fused chain of sinks driven by from_enumerable::push
+// o batch: next_batch through every adaptor
+// o sum: whatever interactive::sum() picks
+void run_push_benchmarks()
+{
+	const int repeat_count = 20;
+	vector<int> values(10000000);
+	for (size_t i = 0; i < values.size(); i++)
+		values[i] = static_cast<int>(i % 1000);
+
+	auto query = [&]()
+	{
+		return linq::from(values)
+			.where([](int n){ return (n % 3) == 0; })
+			.select([](int n){ return static_cast<long long>(n) * 2; });
+	};
+
+	BenchmarkUtils::time_it("where.select.sum pull ", repeat_count, [&]()
+	{
+		auto q = query();
+		auto e = q.get_enumerator();
+		long long sum = 0;
+		if (e.move_first())
+		{
+			do
+			{
+				sum += e.current();
+			} while (e.move_next());
+		}
+		BenchmarkUtils::consume(sum);
+	});
+
+	BenchmarkUtils::time_it("where.select.sum push ", repeat_count, [&]()
+	{
+		auto q = query();
+		long long sum = 0;
+		auto sink = [&](long long n) -> bool
+		{
+			sum += n;
+			return true;
+		};
+		linq::push(q, sink);
+		BenchmarkUtils::consume(sum);
+	});
+
+	BenchmarkUtils::time_it("where.select.sum batch", repeat_count, [&]()
+	{
+		auto q = query();
+		auto e = q.get_enumerator();
+		linq::batch_reader<decltype(e)> reader(e);
+		long long buffer[512];
+		long long sum = 0;
+		size_t count;
+		do
+		{
+			count = reader.next_batch(buffer, 512);
+			for (size_t i = 0; i < count; i++)
+				sum += buffer[i];
+		} while (count == 512);
+		BenchmarkUtils::consume(sum);
+	});
+
+	BenchmarkUtils::time_it("where.select.sum sum()", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(query().sum());
+	});
+
+	//where() calls current() on its source twice per surviving value, so pull runs this selector twice
+	auto hash = [](int n) -> long long
+	{
+		unsigned long long h = static_cast<unsigned long long>(n);
+		for (int i = 0; i < 8; i++)
+			h = (h ^ (h >> 29)) * 0xbf58476d1ce4e5b9ULL;
+		return static_cast<long long>(h >> 40);
+	};
+
+	BenchmarkUtils::time_it("select.where.sum pull ", repeat_count, [&]()
+	{
+		auto q = linq::from(values)
+			.select(hash)
+			.where([](long long n){ return (n & 1) == 0; });
+		auto e = q.get_enumerator();
+		long long sum = 0;
+		if (e.move_first())
+		{
+			do
+			{
+				sum += e.current();
+			} while (e.move_next());
+		}
+		BenchmarkUtils::consume(sum);
+	});
+
+	BenchmarkUtils::time_it("select.where.sum sum()", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(values)
+			.select(hash)
+			.where([](long long n){ return (n & 1) == 0; })
+			.sum());
+	});
+
+	BenchmarkUtils::time_it("select.take_while.count pull", repeat_count, [&]()
+	{
+		auto q = linq::from(values)
+			.select([](int n){ return n + 1; })
+			.take_while([](int n){ return n > 0; });
+		auto e = q.get_enumerator();
+		size_t count = 0;
+		if (e.move_first())
+		{
+			do
+			{
+				++count;
+			} while (e.move_next());
+		}
+		BenchmarkUtils::consume(count);
+	});
+
+	BenchmarkUtils::time_it("select.take_while.count push", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(values)
+			.select([](int n){ return n + 1; })
+			.take_while([](int n){ return n > 0; })
+			.count());
+	});
+}
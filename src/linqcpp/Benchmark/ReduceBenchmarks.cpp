@@ -0,0 +1,99 @@
+#include <linqcpp/linq/interactive.h>
+#include "BenchmarkUtils.h"
+#include "Benchmarks.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// sum, min, max, minmax and count_if over 16M ints and doubles, with the kernels of each instruction set
+// the CPU has, against a plain loop
+void run_reduce_benchmarks()
+{
+	const int repeat_count = 5;
+	vector<int> ints(16000000);
+	vector<double> doubles(ints.size());
+	unsigned long long state = 88172645463325252ULL;
+	for (size_t i = 0; i < ints.size(); i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		ints[i] = static_cast<int>(state >> 40);
+		doubles[i] = static_cast<double>(state >> 11) / 9007199254740992.0;
+	}
+
+	BenchmarkUtils::time_it("loop sum doubles", repeat_count, [&]()
+	{
+		double sum = 0;
+		for (auto value = doubles.begin(); value != doubles.end(); ++value)
+			sum += *value;
+		BenchmarkUtils::consume(sum);
+	});
+
+	BenchmarkUtils::time_it("loop minmax ints", repeat_count, [&]()
+	{
+		int min = ints[0], max = ints[0];
+		for (auto value = ints.begin(); value != ints.end(); ++value)
+		{
+			if (*value < min)
+				min = *value;
+			else if (max < *value)
+				max = *value;
+		}
+		BenchmarkUtils::consume(min + max);
+	});
+
+	const char* level_names[] = { "scalar", "sse2", "avx2" };
+	linq::simd::level_type detected = linq::simd::active_level();
+	for (int level = detected; level >= linq::simd::scalar_level; --level)
+	{
+		linq::simd::active_level() = static_cast<linq::simd::level_type>(level);
+		string suffix = string(" (") + level_names[level] + ")";
+
+		BenchmarkUtils::time_it("sum ints" + suffix, repeat_count, [&]()
+		{
+			BenchmarkUtils::consume(linq::from(ints).sum());
+		});
+
+		//take_while neither batches nor is contiguous, so the values are summed one by one
+		BenchmarkUtils::time_it("sum of take_while ints" + suffix, repeat_count, [&]()
+		{
+			BenchmarkUtils::consume(linq::from(ints).take_while([](int x){ return x >= 0; }).sum());
+		});
+
+		BenchmarkUtils::time_it("sum doubles" + suffix, repeat_count, [&]()
+		{
+			BenchmarkUtils::consume(linq::from(doubles).sum());
+		});
+
+		BenchmarkUtils::time_it("sum of select doubles" + suffix, repeat_count, [&]()
+		{
+			BenchmarkUtils::consume(linq::from(doubles).select([](double x){ return x * 2; }).sum());
+		});
+
+		BenchmarkUtils::time_it("minmax ints" + suffix, repeat_count, [&]()
+		{
+			auto range = linq::from(ints).minmax();
+			BenchmarkUtils::consume(range.first + range.second);
+		});
+
+		BenchmarkUtils::time_it("min doubles" + suffix, repeat_count, [&]()
+		{
+			BenchmarkUtils::consume(linq::from(doubles).min());
+		});
+
+		BenchmarkUtils::time_it("max of select ints" + suffix, repeat_count, [&]()
+		{
+			BenchmarkUtils::consume(linq::from(ints).select([](int x){ return x ^ 0x5555; }).max());
+		});
+	}
+	linq::simd::active_level() = detected;
+
+	BenchmarkUtils::time_it("count_if ints", repeat_count, [&]()
+	{
+		BenchmarkUtils::consume(linq::from(ints).count_if([](int x){ return x < (1 << 22); }));
+	});
+}
\ No newline at end of file
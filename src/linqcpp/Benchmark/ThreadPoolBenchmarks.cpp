@@ -0,0 +1,98 @@
+#include <linqcpp/linq/thread_pool.h>
+#include "BenchmarkUtils.h"
+#include "Benchmarks.h"
+
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+	unsigned long long mix(unsigned long long h)
+	{
+		for (int i = 0; i < 16; i++)
+			h = (h ^ (h >> 29)) * 0xbf58476d1ce4e5b9ULL;
+		return h;
+	}
+
+	//recursive fork/join, so most tasks are spawned by workers and balanced by stealing
+	unsigned long long fork_join_sum(linq::thread_pool& pool, size_t begin, size_t end)
+	{
+		if (end - begin <= 4096)
+		{
+			unsigned long long sum = 0;
+			for (size_t i = begin; i < end; i++)
+				sum += mix(i);
+			return sum;
+		}
+		size_t middle = begin + (end - begin) / 2;
+		unsigned long long left = 0;
+		linq::task_group group(pool);
+		group.run([&](){ left = fork_join_sum(pool, begin, middle); });
+		unsigned long long right = fork_join_sum(pool, middle, end);
+		group.wait();
+		return left + right;
+	}
+
+}
+
+// Scaling of the thread pool across worker counts
+// o chunks: one flat task_group of equal chunks submitted from outside the pool
+// o fork/join: recursive halving, balanced by work stealing
+void run_thread_pool_benchmarks()
+{
+	const int repeat_count = 5;
+	const size_t size = 1 << 23;
+	const size_t chunk_count = 256;
+
+	vector<size_t> worker_counts;
+	size_t hardware = thread::hardware_concurrency();
+	for (size_t n = 1; n < hardware; n *= 2)
+		worker_counts.push_back(n);
+	worker_counts.push_back(hardware == 0 ? 1 : hardware);
+
+	for (auto workers = worker_counts.begin(); workers != worker_counts.end(); ++workers)
+	{
+		linq::thread_pool pool(*workers);
+
+		ostringstream chunks_name;
+		chunks_name << "chunks    workers=" << *workers;
+		BenchmarkUtils::time_it(chunks_name.str(), repeat_count, [&]()
+		{
+			vector<unsigned long long> partials(chunk_count);
+			linq::task_group group(pool);
+			for (size_t c = 0; c < chunk_count; c++)
+			{
+				group.run([&, c]()
+				{
+					unsigned long long sum = 0;
+					for (size_t i = c * size / chunk_count; i < (c + 1) * size / chunk_count; i++)
+						sum += mix(i);
+					partials[c] = sum;
+				});
+			}
+			group.wait();
+			unsigned long long sum = 0;
+			for (size_t c = 0; c < chunk_count; c++)
+				sum += partials[c];
+			BenchmarkUtils::consume(sum);
+		});
+
+		ostringstream fork_join_name;
+		fork_join_name << "fork/join workers=" << *workers;
+		BenchmarkUtils::time_it(fork_join_name.str(), repeat_count, [&]()
+		{
+			unsigned long long sum = 0;
+			linq::task_group group(pool);
+			group.run([&](){ sum = fork_join_sum(pool, 0, size); });
+			group.wait();
+			BenchmarkUtils::consume(sum);
+		});
+	}
+}
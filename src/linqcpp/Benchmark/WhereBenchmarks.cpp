@@ -0,0 +1,74 @@
+#include <linqcpp/linq/interactive.h>
+#include "BenchmarkUtils.h"
+#include "Benchmarks.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// where over 16M ints at 5%, 25% and 50% selectivity, collected and summed, with the compaction (and expression
+// evaluation) of each instruction set the CPU has, against a plain loop
+void run_where_benchmarks()
+{
+	const int repeat_count = 5;
+	vector<int> ints(16000000);
+	unsigned long long state = 88172645463325252ULL;
+	for (size_t i = 0; i < ints.size(); i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		ints[i] = static_cast<int>(state % 100);
+	}
+
+	const int selectivities[] = { 5, 25, 50 };
+	for (size_t s = 0; s < sizeof(selectivities) / sizeof(selectivities[0]); s++)
+	{
+		int selectivity = selectivities[s];
+		auto predicate = [=](int x){ return x < selectivity; };
+		string percent = " " + to_string(selectivity) + "%";
+
+		BenchmarkUtils::time_it("loop to vector" + percent, repeat_count, [&]()
+		{
+			vector<int> selected;
+			for (auto value = ints.begin(); value != ints.end(); ++value)
+			{
+				if (predicate(*value))
+					selected.push_back(*value);
+			}
+			BenchmarkUtils::consume(selected.size());
+		});
+
+		const char* level_names[] = { "scalar", "sse2", "avx2" };
+		linq::simd::level_type detected = linq::simd::active_level();
+		for (int level = detected; level >= linq::simd::scalar_level; --level)
+		{
+			linq::simd::active_level() = static_cast<linq::simd::level_type>(level);
+			string suffix = percent + " (" + level_names[level] + ")";
+
+			BenchmarkUtils::time_it("where to vector" + suffix, repeat_count, [&]()
+			{
+				BenchmarkUtils::consume(linq::from(ints).where(predicate).to_vector().size());
+			});
+
+			BenchmarkUtils::time_it("where sum" + suffix, repeat_count, [&]()
+			{
+				BenchmarkUtils::consume(linq::from(ints).where(predicate).sum());
+			});
+
+			BenchmarkUtils::time_it("where expression sum" + suffix, repeat_count, [&]()
+			{
+				using namespace linq::placeholders;
+				BenchmarkUtils::consume(linq::from(ints).where(_1 < selectivity).sum());
+			});
+
+			BenchmarkUtils::time_it("select where sum" + suffix, repeat_count, [&]()
+			{
+				BenchmarkUtils::consume(linq::from(ints).select([](int x){ return x ^ 1; }).where(predicate).sum());
+			});
+		}
+		linq::simd::active_level() = detected;
+	}
+}
\ No newline at end of file
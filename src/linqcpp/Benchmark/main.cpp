@@ -0,0 +1,58 @@
+#include "Benchmarks.h"
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+
+using namespace std;
+
+// Usage: Benchmark [name...]
+// Runs the named benchmark groups, or all of them if none are named
+int main(int argc, char* argv[])
+{
+	map<string, function<void ()>> groups;
+	groups["push"] = run_push_benchmarks;
+	groups["thread_pool"] = run_thread_pool_benchmarks;
+	groups["parallel"] = run_parallel_benchmarks;
+	groups["order_by"] = run_order_by_benchmarks;
+	groups["merge"] = run_merge_benchmarks;
+	groups["group_by"] = run_group_by_benchmarks;
+	groups["join"] = run_join_benchmarks;
+	groups["distinct"] = run_distinct_benchmarks;
+	groups["reduce"] = run_reduce_benchmarks;
+	groups["where"] = run_where_benchmarks;
+	groups["capture"] = run_capture_benchmarks;
+	groups["memory"] = run_memory_benchmarks;
+	groups["memoize"] = run_memoize_benchmarks;
+
+	try
+	{
+		if (argc < 2)
+		{
+			for (auto group = groups.begin(); group != groups.end(); ++group)
+			{
+				cout << "== " << group->first << endl;
+				group->second();
+			}
+		}
+		for (int i = 1; i < argc; i++)
+		{
+			auto group = groups.find(argv[i]);
+			if (group == groups.end())
+			{
+				cout << "Unknown benchmark group: " << argv[i] << endl;
+				return EXIT_FAILURE;
+			}
+			cout << "== " << group->first << endl;
+			group->second();
+		}
+	}
+	catch(exception& e)
+	{
+		cout << "The benchmark crashed from the following exception: " << e.what() << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,151 @@
+#include <linqcpp/linq/interactive.h>
+#include <linqcpp/linq/flat_hash.h>
+#include "TestUtils.h"
+#include "Tests.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+	//counts its copies, to see when a key is copied
+	struct counted
+	{
+		static int copies;
+
+		int value;
+
+		counted(int value)
+			: value(value)
+		{
+		}
+
+		counted(counted const& other)
+			: value(other.value)
+		{
+			++copies;
+		}
+
+		counted& operator=(counted const& other)
+		{
+			value = other.value;
+			++copies;
+			return *this;
+		}
+
+		bool operator==(counted const& other) const
+		{
+			return value == other.value;
+		}
+	};
+
+	int counted::copies = 0;
+
+	struct counted_hash
+	{
+		size_t operator()(counted const& key) const
+		{
+			return static_cast<size_t>(key.value);
+		}
+	};
+
+	//only constructible from a value
+	struct no_default
+	{
+		int value;
+
+		explicit no_default(int value)
+			: value(value)
+		{
+		}
+
+		bool operator==(no_default const& other) const
+		{
+			return value == other.value;
+		}
+	};
+
+	struct no_default_hash
+	{
+		size_t operator()(no_default const& key) const
+		{
+			return static_cast<size_t>(key.value);
+		}
+	};
+
+	//pulls every value of query through its enumerator, as operators without push do
+	template <typename Query>
+	int pull_sum(Query& query)
+	{
+		int sum = 0;
+		auto e = query.get_enumerator();
+		for (bool has_value = e.move_first(); has_value; has_value = e.move_next())
+			sum += e.current();
+		return sum;
+	}
+
+	void test_current_evaluated_once()
+	{
+		vector<int> cycling;
+		vector<int> runs;
+		for (int i = 0; i < 100; i++)
+		{
+			cycling.push_back(i % 10);
+			runs.push_back(i / 10);
+		}
+
+		int calls = 0;
+		auto distinct = linq::from(cycling).select([&](int n){ ++calls; return n * 2; }).distinct();
+		TestUtils::check(pull_sum(distinct) == 90, "distinct: pulled values");
+		TestUtils::check(calls == 100, "distinct: current() is evaluated once per value");
+
+		calls = 0;
+		auto distinct_sorted = linq::from(runs).select([&](int n){ ++calls; return n * 2; }).distinct_sorted();
+		TestUtils::check(pull_sum(distinct_sorted) == 90, "distinct_sorted: pulled values");
+		TestUtils::check(calls == 100, "distinct_sorted: current() is evaluated once per value");
+
+		//references into the source
+		auto references = linq::from(runs).distinct_sorted();
+		TestUtils::check(pull_sum(references) == 45, "distinct_sorted: pulled references");
+	}
+
+	void test_values()
+	{
+		vector<no_default> values;
+		for (int i = 0; i < 20; i++)
+			values.push_back(no_default(i % 4));
+		vector<no_default> distinct = linq::from(values)
+			.select([](no_default const& value){ return value; })
+			.distinct(no_default_hash())
+			.to_vector();
+		TestUtils::check(distinct.size() == 4 && distinct[3].value == 3, "distinct: values that are not default constructible");
+
+		vector<string> words;
+		words.push_back("a");
+		words.push_back("b");
+		words.push_back("a");
+		TestUtils::check(linq::from(words).select([](string const& word){ return word + "!"; }).distinct().count() == 2, "distinct: strings");
+	}
+
+	void test_keys_copied_on_insert()
+	{
+		linq::flat_hash_index<counted, counted_hash> index;
+		counted key(7);
+		counted::copies = 0;
+		TestUtils::check(index.insert(key).second, "flat_hash_index: a new key is inserted");
+		TestUtils::check(!index.insert(key).second, "flat_hash_index: a key is inserted once");
+		TestUtils::check(!index.insert(counted(7)).second, "flat_hash_index: an equal rvalue key is found");
+		TestUtils::check(counted::copies == 1, "flat_hash_index: a key is copied only when it is inserted");
+	}
+
+}
+
+void run_distinct_tests()
+{
+	test_current_evaluated_once();
+	test_values();
+	test_keys_copied_on_insert();
+}
\ No newline at end of file
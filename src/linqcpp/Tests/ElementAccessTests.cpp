@@ -0,0 +1,66 @@
+#include <linqcpp/linq/interactive.h>
+#include "TestUtils.h"
+#include "Tests.h"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+	//true if f throws a std::logic_error by pointer, as the library does
+	template <typename F>
+	bool throws_logic_error(F f)
+	{
+		try
+		{
+			f();
+		}
+		catch(logic_error* e)
+		{
+			delete e;
+			return true;
+		}
+		return false;
+	}
+
+	void test_element_at()
+	{
+		vector<int> values;
+		for (int i = 0; i < 10; i++)
+			values.push_back(i * i);
+
+		//random access, and enumerated value by value
+		TestUtils::check(linq::from(values).element_at(3) == 9, "element_at: random access");
+		TestUtils::check(linq::from(values).where([](int){ return true; }).element_at(3) == 9, "element_at: enumerated");
+
+		TestUtils::check(throws_logic_error([&](){ linq::from(values).element_at(10); }), "element_at: random access, past the end throws");
+		TestUtils::check(throws_logic_error([&](){ linq::from(values).where([](int){ return true; }).element_at(10); }), "element_at: enumerated, past the end throws");
+
+		vector<int> none;
+		TestUtils::check(throws_logic_error([&](){ linq::from(none).where([](int){ return true; }).element_at(0); }), "element_at: empty sequence throws");
+	}
+
+	void test_last()
+	{
+		vector<int> values;
+		for (int i = 0; i < 10; i++)
+			values.push_back(i * i);
+
+		TestUtils::check(linq::from(values).last() == 81, "last: random access");
+		TestUtils::check(linq::from(values).where([](int n){ return n < 50; }).last() == 49, "last: enumerated");
+		TestUtils::check(linq::from(values).select([](int n){ return n + 1; }).where([](int n){ return n < 50; }).last() == 37, "last: enumerated values");
+
+		vector<int> none;
+		TestUtils::check(throws_logic_error([&](){ linq::from(none).last(); }), "last: random access, empty sequence throws");
+		TestUtils::check(throws_logic_error([&](){ linq::from(none).where([](int){ return true; }).last(); }), "last: enumerated, empty sequence throws");
+	}
+
+}
+
+void run_element_access_tests()
+{
+	test_element_at();
+	test_last();
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include <linqcpp/linq/interactive.h>
+#include <linqcpp/linq/expression.h>
+#include <linqcpp/linq/simd_kernels.h>
+#include "TestUtils.h"
+#include "Tests.h"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using linq::placeholders::_1;
+
+namespace {
+
+	struct point
+	{
+		int x;
+		int y;
+	};
+
+	//-500 to 500, so 0 is among the values
+	vector<int> make_values()
+	{
+		vector<int> values;
+		for (int i = -500; i <= 500; i++)
+			values.push_back(i);
+		return values;
+	}
+
+	//the right side of && and || is evaluated only when the left side does not decide the result
+	void test_short_circuit_guards(string const& level)
+	{
+		auto nonzero_and = _1 != 0 && 100 / _1 > 2;
+		auto zero_or = _1 == 0 || 100 % _1 == 0;
+		TestUtils::check(!nonzero_and(0), "expression: && guards a division, called directly" + level);
+		TestUtils::check(zero_or(0), "expression: || guards a remainder, called directly" + level);
+		TestUtils::check(nonzero_and(10) && !nonzero_and(50), "expression: && past the guard, called directly" + level);
+
+		vector<int> values = make_values();
+		vector<int> expected_and = linq::from(values).where([](int n){ return n != 0 && 100 / n > 2; }).to_vector();
+		vector<int> expected_or = linq::from(values).where([](int n){ return n == 0 || 100 % n == 0; }).to_vector();
+		TestUtils::check(linq::from(values).where(nonzero_and).to_vector() == expected_and, "expression: && guards a division in where" + level);
+		TestUtils::check(linq::from(values).where(zero_or).to_vector() == expected_or, "expression: || guards a remainder in where" + level);
+		TestUtils::check(linq::from(values).where(_1 != 0 && 100 / _1 > 2).count() == 33, "expression: && guarded count" + level);
+	}
+
+	//expressions without divisions are evaluated a block at a time, and must match the lambdas they stand for
+	void test_block_expressions(string const& level)
+	{
+		vector<int> values = make_values();
+		TestUtils::check(linq::from(values).where(_1 > 100 && _1 < 400).to_vector()
+			== linq::from(values).where([](int n){ return n > 100 && n < 400; }).to_vector(), "expression: where with &&" + level);
+		TestUtils::check(linq::from(values).where(_1 < -300 || (_1 & 7) == 3).to_vector()
+			== linq::from(values).where([](int n){ return n < -300 || (n & 7) == 3; }).to_vector(), "expression: where with ||" + level);
+		TestUtils::check(linq::from(values).select(_1 * 3 - 7).to_vector()
+			== linq::from(values).select([](int n){ return n * 3 - 7; }).to_vector(), "expression: select" + level);
+		TestUtils::check(linq::from(values).select(_1 * 2).sum() == 0, "expression: select then sum" + level);
+
+		vector<point> points;
+		for (int i = 0; i < 1000; i++)
+		{
+			point value = { i % 37, i };
+			points.push_back(value);
+		}
+		TestUtils::check(linq::from(points).where((_1->*&point::x) == 5).count() == 27, "expression: where over a member" + level);
+		TestUtils::check(linq::from(points).select((_1->*&point::y) * 2).sum() == 999000, "expression: select of a member" + level);
+	}
+
+}
+
+//with the evaluation of every instruction set the CPU has
+void run_expression_tests()
+{
+	const char* level_names[] = { "scalar", "sse2", "avx2" };
+	linq::simd::level_type detected = linq::simd::active_level();
+	for (int level = detected; level >= linq::simd::scalar_level; --level)
+	{
+		linq::simd::active_level() = static_cast<linq::simd::level_type>(level);
+		string name = string(" (") + level_names[level] + ")";
+		test_short_circuit_guards(name);
+		test_block_expressions(name);
+	}
+	linq::simd::active_level() = detected;
+}
\ No newline at end of file
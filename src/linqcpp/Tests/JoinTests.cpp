@@ -0,0 +1,84 @@
+#include <linqcpp/linq/interactive.h>
+#include "TestUtils.h"
+#include "Tests.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+	typedef pair<int, int> match;
+
+	//pulls every value of query through its enumerator, as operators without push do
+	template <typename Query>
+	vector<match> pull(Query& query)
+	{
+		vector<match> values;
+		auto e = query.get_enumerator();
+		for (bool has_value = e.move_first(); has_value; has_value = e.move_next())
+			values.push_back(e.current());
+		return values;
+	}
+
+	//pairs of (outer index, inner index) with equal keys, outer index by outer index
+	vector<match> outer_major(vector<int> const& outer, vector<int> const& inner)
+	{
+		vector<match> matches;
+		for (size_t i = 0; i < outer.size(); i++)
+		{
+			for (size_t j = 0; j < inner.size(); j++)
+			{
+				if (outer[i] == inner[j])
+					matches.push_back(match(static_cast<int>(i), static_cast<int>(j)));
+			}
+		}
+		return matches;
+	}
+
+	//a few outer keys against many inner ones, so the outer side has the smaller size hint
+	void test_outer_order()
+	{
+		vector<int> outer;
+		outer.push_back(7);
+		outer.push_back(3);
+		outer.push_back(7);
+		outer.push_back(5);
+		vector<int> inner;
+		for (int i = 0; i < 1000; i++)
+			inner.push_back((i * 37) % 11);
+		vector<match> expected = outer_major(outer, inner);
+
+		vector<int> outer_ids;
+		for (size_t i = 0; i < outer.size(); i++)
+			outer_ids.push_back(static_cast<int>(i));
+		vector<int> inner_ids;
+		for (size_t j = 0; j < inner.size(); j++)
+			inner_ids.push_back(static_cast<int>(j));
+
+		auto outer_key = [&outer](int i){ return outer[i]; };
+		auto inner_key = [&inner](int j){ return inner[j]; };
+		auto result = [](int i, int j){ return match(i, j); };
+
+		auto pushed = linq::from(outer_ids).join(linq::from(inner_ids), outer_key, inner_key, result).to_vector();
+		TestUtils::check(pushed == expected, "join: pushed results come in outer order");
+		auto pulled = linq::from(outer_ids).join(linq::from(inner_ids), outer_key, inner_key, result);
+		TestUtils::check(pull(pulled) == expected, "join: enumerated results come in outer order");
+
+		//the smaller outer side is built, and results come inner index by inner index
+		vector<match> inner_major = expected;
+		stable_sort(inner_major.begin(), inner_major.end(), [](match const& a, match const& b){ return a.second < b.second; });
+		auto smaller_pushed = linq::from(outer_ids).join(linq::from(inner_ids), outer_key, inner_key, result).build_smaller_side().to_vector();
+		TestUtils::check(smaller_pushed == inner_major, "join: build_smaller_side, pushed results come in inner order");
+		auto smaller_pulled = linq::from(outer_ids).join(linq::from(inner_ids), outer_key, inner_key, result).build_smaller_side();
+		TestUtils::check(pull(smaller_pulled) == inner_major, "join: build_smaller_side, enumerated results come in inner order");
+	}
+
+}
+
+void run_join_tests()
+{
+	test_outer_order();
+}
\ No newline at end of file
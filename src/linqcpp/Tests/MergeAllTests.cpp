@@ -0,0 +1,81 @@
+#include <linqcpp/linq/interactive.h>
+#include "TestUtils.h"
+#include "Tests.h"
+
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+	//only constructible from a value
+	struct no_default
+	{
+		int value;
+
+		explicit no_default(int value)
+			: value(value)
+		{
+		}
+
+		bool operator<(no_default const& other) const
+		{
+			return value < other.value;
+		}
+	};
+
+	//shards of 0 to count - 1, value i in shard i % shard_count
+	vector<vector<no_default>> make_shards(int count, int shard_count)
+	{
+		vector<vector<no_default>> shards(shard_count);
+		for (int i = 0; i < count; i++)
+			shards[i % shard_count].push_back(no_default(i));
+		return shards;
+	}
+
+	bool is_sequence(vector<no_default> const& values, int count)
+	{
+		if (values.size() != static_cast<size_t>(count))
+			return false;
+		for (int i = 0; i < count; i++)
+		{
+			if (values[i].value != i)
+				return false;
+		}
+		return true;
+	}
+
+	void test_values_without_default()
+	{
+		vector<vector<no_default>> shards = make_shards(1000, 7);
+		vector<decltype(linq::from(shards[0]))> sources;
+		for (auto shard = shards.begin(); shard != shards.end(); ++shard)
+			sources.push_back(linq::from(*shard));
+		TestUtils::check(is_sequence(linq::merge_all(sources).to_vector(), 1000), "merge_all: values that are not default constructible");
+
+		vector<decltype(linq::from(shards[0]))> keyed_sources;
+		for (auto shard = shards.begin(); shard != shards.end(); ++shard)
+			keyed_sources.push_back(linq::from(*shard));
+		TestUtils::check(is_sequence(linq::merge_all(keyed_sources, [](no_default const& value){ return no_default(value.value * 2); }).to_vector(), 1000),
+			"merge_all: keys that are not default constructible");
+	}
+
+	//exhausted sources drop out of the merge, including ones that are empty from the start
+	void test_uneven_sources()
+	{
+		vector<vector<no_default>> shards = make_shards(10, 3);
+		shards.push_back(vector<no_default>());
+		shards.insert(shards.begin(), vector<no_default>());
+		vector<decltype(linq::from(shards[0]))> sources;
+		for (auto shard = shards.begin(); shard != shards.end(); ++shard)
+			sources.push_back(linq::from(*shard));
+		TestUtils::check(is_sequence(linq::merge_all(sources).to_vector(), 10), "merge_all: uneven and empty sources");
+	}
+
+}
+
+void run_merge_all_tests()
+{
+	test_values_without_default();
+	test_uneven_sources();
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include <linqcpp/linq/interactive.h>
+#include "TestUtils.h"
+#include "Tests.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+	struct item
+	{
+		int key;
+		int id;
+	};
+
+	vector<item> make_items(int count)
+	{
+		vector<item> items;
+		for (int i = 0; i < count; i++)
+		{
+			item value = { static_cast<int>((static_cast<unsigned>(i) * 2654435761u) >> 20) % 500, i };
+			items.push_back(value);
+		}
+		return items;
+	}
+
+	//the ids of the stable ordering of items by key, from first up to (not including) last
+	vector<int> expected_ids(vector<item> items, size_t first, size_t last)
+	{
+		stable_sort(items.begin(), items.end(), [](item const& a, item const& b){ return a.key < b.key; });
+		vector<int> ids;
+		for (size_t i = first; i < last && i < items.size(); i++)
+			ids.push_back(items[i].id);
+		return ids;
+	}
+
+	vector<int> ids_of(vector<item> const& items)
+	{
+		vector<int> ids;
+		for (auto value = items.begin(); value != items.end(); ++value)
+			ids.push_back(value->id);
+		return ids;
+	}
+
+	//terminal operators read one value, but must not limit what later enumerations of the same query produce
+	void test_terminal_operators_keep_the_source_whole()
+	{
+		vector<item> items = make_items(100);
+		auto query = linq::from(items).order_by([](item const& value){ return value.key; });
+
+		TestUtils::check(query.first().id == expected_ids(items, 0, 1)[0], "order_by: first");
+		TestUtils::check(query.to_vector().size() == 100, "order_by: to_vector after first");
+
+		TestUtils::check(query.first_or_default().id == expected_ids(items, 0, 1)[0], "order_by: first_or_default");
+		TestUtils::check(query.element_at(5).id == expected_ids(items, 5, 6)[0], "order_by: element_at");
+		TestUtils::check(query.count() == 100, "order_by: count after first_or_default and element_at");
+	}
+
+	//take and skip(..).take order only the values they return, which must match the stable full sort
+	void test_windows()
+	{
+		vector<item> items = make_items(20000);
+		size_t skips[] = { 0, 1, 100, 1020, 5000, 19990, 20000, 30000 };
+		size_t takes[] = { 0, 1, 10, 50, 3000, 100000 };
+		for (size_t s = 0; s < sizeof(skips) / sizeof(skips[0]); s++)
+		{
+			for (size_t t = 0; t < sizeof(takes) / sizeof(takes[0]); t++)
+			{
+				size_t skip = skips[s];
+				size_t take = takes[t];
+				string window = "skip(" + to_string(skip) + ").take(" + to_string(take) + ")";
+				vector<int> expected = expected_ids(items, skip, skip + take);
+
+				TestUtils::check(ids_of(linq::from(items)
+					.order_by([](item const& value){ return value.key; })
+					.skip(skip)
+					.take(take)
+					.to_vector()) == expected, "order_by: radix keys, " + window);
+
+				TestUtils::check(ids_of(linq::from(items)
+					.order_by([](item const& value){ return static_cast<double>(value.key); })
+					.then_by([](item const& value){ return value.key % 2; })
+					.skip(skip)
+					.take(take)
+					.to_vector()) == expected, "order_by: compared keys, " + window);
+
+				TestUtils::check(ids_of(linq::from(items)
+					.order_by([](item const& value){ return value.key; })
+					.then_by([](item const& value){ return value.key; })
+					.normalized_keys()
+					.skip(skip)
+					.take(take)
+					.to_vector()) == expected, "order_by: normalized keys, " + window);
+			}
+		}
+
+		auto skipped = linq::from(items).order_by([](item const& value){ return value.key; }).skip(100);
+		TestUtils::check(skipped.count() == 19900, "order_by: count after skip");
+		TestUtils::check(ids_of(skipped.take(10).to_vector()) == expected_ids(items, 100, 110), "order_by: take after an enumerated skip");
+	}
+
+	//sorted runs spilled to files are merged, and the window is cut from the merge
+	void test_spilled_windows()
+	{
+		vector<int> values;
+		for (int i = 0; i < 20000; i++)
+			values.push_back(static_cast<int>((static_cast<unsigned>(i) * 2654435761u) >> 12) % 777);
+		vector<int> sorted = values;
+		sort(sorted.begin(), sorted.end());
+
+		size_t skips[] = { 0, 1500, 19990 };
+		for (size_t s = 0; s < sizeof(skips) / sizeof(skips[0]); s++)
+		{
+			vector<int> window = linq::from(values)
+				.order_by([](int value){ return value; })
+				.memory_budget(sizeof(int) * 3000)
+				.skip(skips[s])
+				.take(2000)
+				.to_vector();
+			size_t last = min(sorted.size(), skips[s] + 2000);
+			TestUtils::check(window == vector<int>(sorted.begin() + skips[s], sorted.begin() + last),
+				"order_by: spilled runs, skip(" + to_string(skips[s]) + ").take(2000)");
+		}
+	}
+
+}
+
+void run_order_by_tests()
+{
+	test_terminal_operators_keep_the_source_whole();
+	test_windows();
+	test_spilled_windows();
+}
\ No newline at end of file
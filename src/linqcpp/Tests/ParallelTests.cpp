@@ -0,0 +1,78 @@
+#include <linqcpp/linq/interactive.h>
+#include <linqcpp/linq/parallel_interactive.h>
+#include <linqcpp/linq/thread_pool.h>
+#include "TestUtils.h"
+#include "Tests.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+	//the message of the std::logic_error* that f throws, or "" if it throws none
+	template <typename F>
+	string logic_error_message(F f)
+	{
+		try
+		{
+			f();
+		}
+		catch(logic_error* e)
+		{
+			string message = e->what();
+			delete e;
+			return message;
+		}
+		return "";
+	}
+
+	//small chunks, so even short sequences are reduced on several workers
+	void test_reductions()
+	{
+		linq::thread_pool pool(2);
+		vector<int> values;
+		for (int i = 0; i < 10000; i++)
+			values.push_back((i * 7919) % 10007 - 5000);
+
+		int min = values[0];
+		int max = values[0];
+		for (auto value = values.begin(); value != values.end(); ++value)
+		{
+			if (*value < min)
+				min = *value;
+			if (max < *value)
+				max = *value;
+		}
+
+		TestUtils::check(linq::from(values).parallel(pool, 100).min() == min, "parallel: min");
+		TestUtils::check(linq::from(values).parallel(pool, 100).max() == max, "parallel: max");
+		auto range = linq::from(values).parallel(pool, 100).minmax();
+		TestUtils::check(range.first == min && range.second == max, "parallel: minmax");
+	}
+
+	//an empty sequence fails exactly like the serial reductions
+	void test_empty_reductions()
+	{
+		linq::thread_pool pool(2);
+		vector<int> none;
+		string serial = logic_error_message([&](){ linq::from(none).min(); });
+		TestUtils::check(!serial.empty(), "parallel: the serial min of an empty sequence throws");
+
+		TestUtils::check(logic_error_message([&](){ linq::from(none).parallel(pool, 100).min(); }) == serial,
+			"parallel: min of an empty sequence throws like the serial min");
+		TestUtils::check(logic_error_message([&](){ linq::from(none).parallel(pool, 100).max(); }) == serial,
+			"parallel: max of an empty sequence throws like the serial max");
+		TestUtils::check(logic_error_message([&](){ linq::from(none).parallel(pool, 100).minmax(); }) == serial,
+			"parallel: minmax of an empty sequence throws like the serial minmax");
+	}
+
+}
+
+void run_parallel_tests()
+{
+	test_reductions();
+	test_empty_reductions();
+}
\ No newline at end of file
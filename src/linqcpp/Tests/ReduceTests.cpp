@@ -0,0 +1,57 @@
+#include <linqcpp/linq/interactive.h>
+#include <linqcpp/linq/simd_kernels.h>
+#include "TestUtils.h"
+#include "Tests.h"
+
+#include <climits>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+	//integer sums wrap around, however the values reach them
+	int wrapping_sum(vector<int> const& values)
+	{
+		unsigned sum = 0;
+		for (auto value = values.begin(); value != values.end(); ++value)
+			sum += static_cast<unsigned>(*value);
+		return static_cast<int>(sum);
+	}
+
+	void test_integer_sums(string const& level)
+	{
+		vector<int> one(1, 42);
+		TestUtils::check(linq::from(one).sum() == 42, "sum: one value, contiguous" + level);
+		TestUtils::check(linq::from(one).take_while([](int){ return true; }).sum() == 42, "sum: one value, value by value" + level);
+
+		vector<int> none;
+		TestUtils::check(linq::from(none).take_while([](int){ return true; }).sum() == 0, "sum: no values, value by value" + level);
+
+		vector<int> values;
+		values.push_back(INT_MAX);
+		values.push_back(2);
+		values.push_back(-5);
+		for (int i = 0; i < 1000; i++)
+			values.push_back(i * 7919);
+		int expected = wrapping_sum(values);
+		TestUtils::check(linq::from(values).sum() == expected, "sum: contiguous, wrapping" + level);
+		TestUtils::check(linq::from(values).take_while([](int){ return true; }).sum() == expected, "sum: value by value, wrapping" + level);
+		TestUtils::check(linq::from(values).select([](int n){ return n; }).sum() == expected, "sum: batched, wrapping" + level);
+	}
+
+}
+
+//with the kernels of every instruction set the CPU has
+void run_reduce_tests()
+{
+	const char* level_names[] = { "scalar", "sse2", "avx2" };
+	linq::simd::level_type detected = linq::simd::active_level();
+	for (int level = detected; level >= linq::simd::scalar_level; --level)
+	{
+		linq::simd::active_level() = static_cast<linq::simd::level_type>(level);
+		test_integer_sums(string(" (") + level_names[level] + ")");
+	}
+	linq::simd::active_level() = detected;
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#include "TestUtils.h"
+#include <iostream>
+
+using namespace std;
+
+int TestUtils::failures = 0;
+
+void TestUtils::check(bool condition, string const& text)
+{
+	if (condition)
+		return;
+	cout << "FAILED: " << text << endl;
+	++failures;
+}
+
+int TestUtils::failure_count()
+{
+	return failures;
+}
\ No newline at end of file
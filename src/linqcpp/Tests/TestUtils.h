@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+
+class TestUtils
+{
+public:
+	//prints text and counts a failure unless condition holds
+	static void check(bool condition, std::string const& text);
+
+	static int failure_count();
+
+private:
+	static int failures;
+};
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+
+void run_thread_pool_tests();
+void run_element_access_tests();
+void run_parallel_tests();
+void run_order_by_tests();
+void run_distinct_tests();
+void run_reduce_tests();
+void run_expression_tests();
+void run_join_tests();
+void run_merge_all_tests();
\ No newline at end of file
@@ -0,0 +1,236 @@
+#include <linqcpp/linq/thread_pool.h>
+#include "TestUtils.h"
+#include "Tests.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+	//spins until done() or a generous timeout; false on timeout, so a broken pool fails instead of hanging
+	template <typename Done>
+	bool wait_until(Done done)
+	{
+		auto deadline = chrono::steady_clock::now() + chrono::seconds(10);
+		while (!done())
+		{
+			if (chrono::steady_clock::now() > deadline)
+				return false;
+			this_thread::yield();
+		}
+		return true;
+	}
+
+	void test_submit()
+	{
+		atomic<int> count(0);
+		atomic<bool> on_worker(false);
+		linq::thread_pool pool(4);
+		TestUtils::check(pool.worker_count() == 4, "thread_pool: worker_count");
+		TestUtils::check(!pool.is_worker(), "thread_pool: the main thread is not a worker");
+
+		pool.submit([&](){ on_worker = pool.is_worker(); ++count; });
+		for (int i = 1; i < 1000; i++)
+			pool.submit([&](){ ++count; });
+		TestUtils::check(wait_until([&](){ return count == 1000; }), "thread_pool: submit runs every task");
+		TestUtils::check(on_worker, "thread_pool: tasks run on a worker");
+	}
+
+	//a task spawns children onto its own deque and then blocks its worker; only other workers can run them
+	void test_stealing()
+	{
+		const int child_count = 100;
+		atomic<int> count(0);
+		atomic<bool> stolen(false);
+		atomic<bool> finished(false);
+		linq::thread_pool pool(2);
+
+		pool.submit([&]()
+		{
+			thread::id parent = this_thread::get_id();
+			for (int i = 0; i < child_count; i++)
+			{
+				pool.submit([&, parent]()
+				{
+					if (this_thread::get_id() != parent)
+						stolen = true;
+					++count;
+				});
+			}
+			wait_until([&](){ return count == child_count; });
+			finished = true;
+		});
+
+		TestUtils::check(wait_until([&](){ return finished.load(); }), "thread_pool: stealing, parent finishes");
+		TestUtils::check(count == child_count, "thread_pool: stealing runs every child of a blocked worker");
+		TestUtils::check(stolen, "thread_pool: stealing runs children on another worker");
+	}
+
+	void test_task_group_wait()
+	{
+		linq::thread_pool pool(2);
+
+		{
+			atomic<int> count(0);
+			linq::task_group group(pool);
+			for (int i = 0; i < 100; i++)
+				group.run([&](){ ++count; });
+			group.wait();
+			TestUtils::check(count == 100, "task_group: wait returns after every task ran");
+		}
+
+		//nested groups wait on workers, which must help rather than deadlock
+		{
+			atomic<int> count(0);
+			linq::task_group outer(pool);
+			for (int i = 0; i < 8; i++)
+			{
+				outer.run([&]()
+				{
+					linq::task_group inner(pool);
+					for (int j = 0; j < 8; j++)
+						inner.run([&](){ ++count; });
+					inner.wait();
+				});
+			}
+			outer.wait();
+			TestUtils::check(count == 64, "task_group: nested groups");
+		}
+
+		//the destructor waits too
+		{
+			atomic<int> count(0);
+			{
+				linq::task_group group(pool);
+				for (int i = 0; i < 10; i++)
+					group.run([&](){ this_thread::sleep_for(chrono::milliseconds(1)); ++count; });
+			}
+			TestUtils::check(count == 10, "task_group: destructor waits");
+		}
+	}
+
+	void test_exception_propagation()
+	{
+		linq::thread_pool pool(2);
+		atomic<int> count(0);
+		linq::task_group group(pool);
+		for (int i = 0; i < 20; i++)
+		{
+			group.run([&, i]()
+			{
+				++count;
+				if (i == 7)
+					throw runtime_error("task 7");
+			});
+		}
+
+		bool caught = false;
+		try
+		{
+			group.wait();
+		}
+		catch(runtime_error& e)
+		{
+			caught = string(e.what()) == "task 7";
+		}
+		TestUtils::check(caught, "task_group: wait rethrows the exception of a task");
+		TestUtils::check(count == 20, "task_group: an exception does not cancel the other tasks");
+
+		bool rethrown = false;
+		try
+		{
+			group.wait();
+		}
+		catch(...)
+		{
+			rethrown = true;
+		}
+		TestUtils::check(!rethrown, "task_group: an exception is rethrown once");
+	}
+
+	void test_shutdown()
+	{
+		atomic<int> count(0);
+		linq::thread_pool pool(1);
+
+		//the worker is busy, so everything behind it is still queued when shutdown begins
+		pool.submit([&]()
+		{
+			this_thread::sleep_for(chrono::milliseconds(20));
+			++count;
+		});
+		for (int i = 0; i < 100; i++)
+			pool.submit([&](){ ++count; });
+		//a task submitted by a task being drained still runs
+		pool.submit([&]()
+		{
+			pool.submit([&](){ ++count; });
+		});
+
+		pool.shutdown();
+		TestUtils::check(count == 102, "thread_pool: shutdown drains queued tasks");
+
+		//idempotent
+		pool.shutdown();
+
+		bool rejected = false;
+		try
+		{
+			pool.submit([&](){ ++count; });
+		}
+		catch(logic_error* e)
+		{
+			rejected = true;
+			delete e;
+		}
+		TestUtils::check(rejected, "thread_pool: submit after shutdown throws");
+		TestUtils::check(count == 102, "thread_pool: a rejected task does not run");
+	}
+
+	//a task_group whose task the pool rejects must still be able to wait
+	void test_task_group_after_shutdown()
+	{
+		linq::thread_pool pool(2);
+		pool.shutdown();
+		atomic<bool> waited(false);
+		bool rejected = false;
+		{
+			linq::task_group group(pool);
+			try
+			{
+				group.run([](){});
+			}
+			catch(logic_error* e)
+			{
+				rejected = true;
+				delete e;
+			}
+			//on a thread of its own, so a hang is reported instead of stalling the test program
+			thread waiter([&](){ group.wait(); waited = true; });
+			if (!wait_until([&](){ return waited.load(); }))
+			{
+				TestUtils::check(false, "task_group: wait returns after the pool rejected a task");
+				_Exit(EXIT_FAILURE);
+			}
+			waiter.join();
+		}
+		TestUtils::check(rejected, "task_group: run rethrows the pool's rejection");
+	}
+
+}
+
+void run_thread_pool_tests()
+{
+	test_submit();
+	test_stealing();
+	test_task_group_wait();
+	test_exception_propagation();
+	test_shutdown();
+	test_task_group_after_shutdown();
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "TestUtils.h"
+#include "Tests.h"
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+
+using namespace std;
+
+// Usage: Tests [name...]
+// Runs the named test groups, or all of them if none are named; fails if any check fails
+int main(int argc, char* argv[])
+{
+	map<string, function<void ()>> groups;
+	groups["thread_pool"] = run_thread_pool_tests;
+	groups["element_access"] = run_element_access_tests;
+	groups["parallel"] = run_parallel_tests;
+	groups["order_by"] = run_order_by_tests;
+	groups["distinct"] = run_distinct_tests;
+	groups["reduce"] = run_reduce_tests;
+	groups["expression"] = run_expression_tests;
+	groups["join"] = run_join_tests;
+	groups["merge_all"] = run_merge_all_tests;
+
+	try
+	{
+		if (argc < 2)
+		{
+			for (auto group = groups.begin(); group != groups.end(); ++group)
+			{
+				cout << "== " << group->first << endl;
+				group->second();
+			}
+		}
+		for (int i = 1; i < argc; i++)
+		{
+			auto group = groups.find(argv[i]);
+			if (group == groups.end())
+			{
+				cout << "Unknown test group: " << argv[i] << endl;
+				return EXIT_FAILURE;
+			}
+			cout << "== " << group->first << endl;
+			group->second();
+		}
+	}
+	catch(exception& e)
+	{
+		cout << "The tests crashed from the following exception: " << e.what() << endl;
+		return EXIT_FAILURE;
+	}
+	catch(exception* e)
+	{
+		cout << "The tests crashed from the following exception: " << e->what() << endl;
+		delete e;
+		return EXIT_FAILURE;
+	}
+
+	if (TestUtils::failure_count() != 0)
+	{
+		cout << TestUtils::failure_count() << " check(s) failed" << endl;
+		return EXIT_FAILURE;
+	}
+	cout << "All checks passed" << endl;
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace linq {
+
+namespace adaptive_sort_detail {
+
+	//runs shorter than this are extended by binary insertion sort
+	static const std::size_t min_run = 32;
+
+	//returns the end of the natural run starting at first, which is descending if it is strictly descending
+	//(strictly, so that reversing it keeps equal values in order)
+	template <typename Iterator, typename Compare>
+	Iterator run_end(Iterator first, Iterator last, Compare& compare, bool& descending)
+	{
+		Iterator next = first + 1;
+		descending = false;
+		if (next == last)
+			return last;
+		if (compare(*next, *first))
+		{
+			descending = true;
+			while (next != last && compare(*next, *(next - 1)))
+				++next;
+		}
+		else
+		{
+			while (next != last && !compare(*next, *(next - 1)))
+				++next;
+		}
+		return next;
+	}
+
+	//true if [first, last) has few enough natural runs (averaging at least min_run values) to be worth merging;
+	//stops at the first run too many, so unordered input is only scanned briefly
+	template <typename Iterator, typename Compare>
+	bool has_long_runs(Iterator first, Iterator last, Compare& compare)
+	{
+		std::size_t max_runs = static_cast<std::size_t>(last - first) / min_run;
+		std::size_t run_count = 0;
+		bool descending;
+		for (Iterator run = first; run != last; run = run_end(run, last, compare, descending))
+		{
+			if (++run_count > max_runs)
+				return false;
+		}
+		return true;
+	}
+
+	//stable binary insertion sort of [first, last), where [first, sorted) is already sorted
+	template <typename Iterator, typename Compare>
+	void insertion_sort(Iterator first, Iterator sorted, Iterator last, Compare& compare)
+	{
+		typedef typename std::iterator_traits<Iterator>::value_type value_type;
+		for (; sorted != last; ++sorted)
+		{
+			Iterator position = std::upper_bound(first, sorted, *sorted, compare);
+			if (position == sorted)
+				continue;
+			value_type value = std::move(*sorted);
+			std::move_backward(position, sorted, sorted + 1);
+			*position = std::move(value);
+		}
+	}
+
+	//stable merge of the adjacent sorted runs [first, middle) and [middle, last);
+	//values already in place at either end are not moved, and only the left remainder is buffered
+	template <typename Iterator, typename Compare>
+	void merge_runs(Iterator first, Iterator middle, Iterator last, Compare& compare, std::vector<typename std::iterator_traits<Iterator>::value_type>& buffer)
+	{
+		first = std::upper_bound(first, middle, *middle, compare);
+		if (first == middle)
+			return;
+		last = std::lower_bound(middle, last, *(middle - 1), compare);
+
+		buffer.assign(std::make_move_iterator(first), std::make_move_iterator(middle));
+		auto a = buffer.begin();
+		Iterator b = middle;
+		Iterator out = first;
+		while (a != buffer.end() && b != last)
+		{
+			if (compare(*b, *a))
+				*out++ = std::move(*b++);
+			else
+				*out++ = std::move(*a++);
+		}
+		std::move(a, buffer.end(), out);
+	}
+
+}
+
+// Stable sort that takes advantage of order already present in [first, last), in the manner of timsort
+// o Natural ascending runs are kept and strictly descending runs reversed; short runs are extended to min_run
+// o Input without long runs (averaging less than min_run values) is left to std::stable_sort
+// o Adjacent runs are merged pairwise, skipping values already in place, until one run remains
+// o Sorted and reverse sorted input take O(n) comparisons; random input O(n log n)
+// o Produces exactly the order of std::stable_sort
+template <typename Iterator, typename Compare>
+void adaptive_stable_sort(Iterator first, Iterator last, Compare compare)
+{
+	typedef typename std::iterator_traits<Iterator>::value_type value_type;
+	if (last - first < 2)
+		return;
+	if (!adaptive_sort_detail::has_long_runs(first, last, compare))
+	{
+		std::stable_sort(first, last, compare);
+		return;
+	}
+
+	std::vector<Iterator> bounds;
+	bounds.push_back(first);
+	for (Iterator run = first; run != last; )
+	{
+		bool descending;
+		Iterator end = adaptive_sort_detail::run_end(run, last, compare, descending);
+		if (descending)
+			std::reverse(run, end);
+		if (static_cast<std::size_t>(end - run) < adaptive_sort_detail::min_run)
+		{
+			Iterator extended = run + static_cast<std::ptrdiff_t>(std::min<std::size_t>(adaptive_sort_detail::min_run, last - run));
+			adaptive_sort_detail::insertion_sort(run, end, extended, compare);
+			end = extended;
+		}
+		bounds.push_back(end);
+		run = end;
+	}
+
+	std::vector<value_type> buffer;
+	while (bounds.size() > 2)
+	{
+		std::vector<Iterator> merged_bounds;
+		std::size_t run_count = bounds.size() - 1;
+		for (std::size_t i = 0; i < run_count; i += 2)
+		{
+			merged_bounds.push_back(bounds[i]);
+			if (i + 1 < run_count)
+				adaptive_sort_detail::merge_runs(bounds[i], bounds[i + 1], bounds[i + 2], compare, buffer);
+		}
+		merged_bounds.push_back(last);
+		bounds.swap(merged_bounds);
+	}
+}
+
+}
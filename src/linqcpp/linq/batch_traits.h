@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Optional extension of concept Enumerator<T>: batched enumeration
+// o typename batch_traits<Enumerator>::batch_type
+//   o batch_type == std::decay<value_type>::type
+// o std::size_t next_batch(batch_type* buffer, std::size_t capacity)
+//   o Writes the next values (at most capacity of them) into buffer and returns how many were written
+//   o Returns less than capacity if and only if the sequence is exhausted
+//   o Must be called on a fresh enumerator, and never mixed with move_first/move_next/current
+// o Enumerators opt in by specializing batch_traits with is_batched == true
+//   o is_batched implies batch_type is trivial, so buffers can be plain arrays
+
+namespace linq {
+
+template <typename Enumerator>
+struct batch_traits
+{
+	typedef typename std::decay<typename Enumerator::value_type>::type batch_type;
+	static const bool is_batched = false;
+};
+
+//number of values pulled per next_batch call by the terminal operators
+template <typename T>
+struct batch_capacity
+{
+	static const std::size_t value = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+};
+
+//true if Function can be called with Args without binding a non-const reference to a buffered copy
+template <typename Function, typename... Args>
+class is_batch_callable
+{
+private:
+	template <typename F>
+	static std::true_type test(decltype(void(std::declval<F&>()(std::declval<Args>()...)))*);
+
+	template <typename F>
+	static std::false_type test(...);
+
+public:
+	static const bool value = decltype(test<Function>(nullptr))::value;
+};
+
+//Reads an enumerator in batches, falling back to move_first/move_next/current if it is not natively batched
+template <typename Enumerator, bool IsBatched = batch_traits<Enumerator>::is_batched>
+class batch_reader
+{
+public:
+	typedef typename batch_traits<Enumerator>::batch_type batch_type;
+
+private:
+	Enumerator& source;
+	bool started;
+	bool exhausted;
+
+public:
+	batch_reader(Enumerator& source)
+		: source(source)
+		, started(false)
+		, exhausted(false)
+	{
+	}
+
+	std::size_t next_batch(batch_type* buffer, std::size_t capacity)
+	{
+		std::size_t count = 0;
+		while (count < capacity && !exhausted)
+		{
+			exhausted = !(started ? source.move_next() : source.move_first());
+			started = true;
+			if (!exhausted)
+			{
+				buffer[count++] = source.current();
+			}
+		}
+		return count;
+	}
+};
+
+template <typename Enumerator>
+class batch_reader<Enumerator, true>
+{
+public:
+	typedef typename batch_traits<Enumerator>::batch_type batch_type;
+
+private:
+	Enumerator& source;
+
+public:
+	batch_reader(Enumerator& source)
+		: source(source)
+	{
+	}
+
+	std::size_t next_batch(batch_type* buffer, std::size_t capacity)
+	{
+		return source.next_batch(buffer, capacity);
+	}
+};
+
+}
@@ -1,12 +1,17 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
 #include "enumerable.h"
 #include "captured_enumerator.h"
+#include "batch_traits.h"
 
 namespace linq {
 
 template <typename T>
-class captured_enumerable : public enumerable<T>
+class captured_enumerable
 {
 public:
 	typedef captured_enumerator<T> enumerator_type;
@@ -42,12 +47,53 @@ public:
 	
 	enumerator_type get_enumerator()
 	{
-		return enumerator_type(std::move(get_enumerator_ptr()));
+		return source_ptr->get_captured_enumerator();
+	}
+
+private:
+	//a batch per virtual call
+	template <typename Sink>
+	bool push(Sink& sink, std::true_type)
+	{
+		typedef typename batch_traits<enumerator_type>::batch_type batch_type;
+		static const std::size_t capacity = batch_capacity<batch_type>::value;
+		batch_type buffer[capacity];
+
+		enumerator_type e = get_enumerator();
+		while (true)
+		{
+			std::size_t count = e.next_batch(buffer, capacity);
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				if (!sink(buffer[i]))
+					return false;
+			}
+			if (count < capacity)
+				return true;
+		}
 	}
 
-	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
+	template <typename Sink>
+	bool push(Sink& sink, std::false_type)
+	{
+		enumerator_type e = get_enumerator();
+		if (!e.move_first())
+			return true;
+		while (true)
+		{
+			if (!sink(e.current()))
+				return false;
+			if (!e.move_next())
+				return true;
+		}
+	}
+
+public:
+	//batched when the values can be buffered, and are not references the sink could tell from a buffered copy
+	template <typename Sink>
+	bool push(Sink& sink)
 	{
-		return source_ptr->get_enumerator_ptr();
+		return push(sink, std::integral_constant<bool, !std::is_reference<value_type>::value && batch_traits<enumerator_type>::is_batched>());
 	}
 };
 
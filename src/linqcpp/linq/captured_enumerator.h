@@ -1,41 +1,143 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
 #include "enumerator.h"
+#include "erased_enumerator.h"
+#include "batch_traits.h"
 
 namespace linq {
 
+// Any Enumerator<T>, type erased: an Enumerator<T> itself, which calls its source through enumerator<T>
+// o Concrete enumerators are wrapped in an erased_enumerator; if that takes at most inline_size bytes it is stored
+//   inline, without a heap allocation, else it is moved to the heap
+// o An enumerator already type erased behind a std::unique_ptr is kept as it is
 template <typename T>
-class captured_enumerator : public enumerator<T>
+class captured_enumerator
 {
 public:
 	typedef T value_type;
 
+	static const std::size_t inline_size = 8 * sizeof(void*);
+
 private:
-	std::unique_ptr<enumerator<value_type>> source_ptr;
+	enum operation
+	{
+		move_operation,
+		destroy_operation
+	};
+
+	//moves source into storage (returning where it is now), or destroys it
+	typedef enumerator<value_type>* (*manager_type)(operation op, enumerator<value_type>* source, void* storage);
+
+	typename std::aligned_storage<inline_size>::type storage;
+	enumerator<value_type>* source_ptr;
+	manager_type manager;
 
 	captured_enumerator(captured_enumerator const&); // not defined
 	captured_enumerator& operator=(captured_enumerator const&); // not defined
 
+	template <typename Enumerator>
+	static enumerator<value_type>* manage_inline(operation op, enumerator<value_type>* source, void* storage)
+	{
+		Enumerator* concrete = static_cast<Enumerator*>(source);
+		Enumerator* moved = op == move_operation ? new (storage) Enumerator(std::move(*concrete)) : nullptr;
+		concrete->~Enumerator();
+		return moved;
+	}
+
+	template <typename Enumerator>
+	static enumerator<value_type>* manage_heap(operation op, enumerator<value_type>* source, void*)
+	{
+		if (op == move_operation)
+			return source;
+		delete static_cast<Enumerator*>(source);
+		return nullptr;
+	}
+
+	void take(captured_enumerator& other)
+	{
+		if (other.manager)
+			source_ptr = other.manager(move_operation, other.source_ptr, &storage);
+		manager = other.manager;
+		other.source_ptr = nullptr;
+		other.manager = nullptr;
+	}
+
+	void reset()
+	{
+		if (manager)
+			manager(destroy_operation, source_ptr, &storage);
+		source_ptr = nullptr;
+		manager = nullptr;
+	}
+
+	template <typename Enumerator>
+	void emplace(Enumerator&& source, std::true_type)
+	{
+		source_ptr = new (&storage) Enumerator(std::move(source));
+		manager = &manage_inline<Enumerator>;
+	}
+
+	template <typename Enumerator>
+	void emplace(Enumerator&& source, std::false_type)
+	{
+		source_ptr = new Enumerator(std::move(source));
+		manager = &manage_heap<Enumerator>;
+	}
+
 public:
 	captured_enumerator()
-		: source_ptr()
+		: source_ptr(nullptr)
+		, manager(nullptr)
 	{
 	}
 
 	captured_enumerator(captured_enumerator&& other)
-		: source_ptr(std::move(other.source_ptr))
+		: source_ptr(nullptr)
+		, manager(nullptr)
 	{
+		take(other);
 	}
 
 	captured_enumerator& operator=(captured_enumerator&& other)
 	{
-		source_ptr = std::move(other.source_ptr);
+		if (this != &other)
+		{
+			reset();
+			take(other);
+		}
 		return *this;
 	}
 
+	//deleted through enumerator<value_type>, like the std::unique_ptr would
 	captured_enumerator(std::unique_ptr<enumerator<value_type>>&& source_ptr)
-		: source_ptr(std::move(source_ptr))
+		: source_ptr(source_ptr.release())
+		, manager(&manage_heap<enumerator<value_type>>)
+	{
+	}
+
+	//moves a concrete enumerator in, inline if it fits
+	template <typename Enumerator>
+	explicit captured_enumerator(Enumerator&& source, typename std::enable_if<
+		!std::is_lvalue_reference<Enumerator>::value &&
+		!std::is_same<Enumerator, captured_enumerator>::value>::type* = nullptr)
+		: source_ptr(nullptr)
+		, manager(nullptr)
+	{
+		typedef erased_enumerator<Enumerator> erased_type;
+		emplace(erased_type(std::move(source)), std::integral_constant<bool,
+			sizeof(erased_type) <= inline_size &&
+			std::alignment_of<erased_type>::value <= std::alignment_of<typename std::aligned_storage<inline_size>::type>::value>());
+	}
+
+	~captured_enumerator()
 	{
+		reset();
 	}
 
 	bool move_first()
@@ -52,6 +154,22 @@ public:
 	{
 		return source_ptr->current();
 	}
+
+	//one virtual call per batch
+	std::size_t next_batch(typename enumerator<value_type>::batch_type* buffer, std::size_t capacity)
+	{
+		return source_ptr->next_batch(buffer, capacity);
+	}
+};
+
+template <typename T>
+const std::size_t captured_enumerator<T>::inline_size;
+
+template <typename T>
+struct batch_traits<captured_enumerator<T>>
+{
+	typedef typename std::decay<T>::type batch_type;
+	static const bool is_batched = std::is_trivial<batch_type>::value;
 };
 
 }
\ No newline at end of file
@@ -2,7 +2,6 @@
 
 #include <utility>
 
-#include "make_unique.h"
 #include "enumerable.h"
 #include "concat_traits.h"
 #include "concat_enumerator.h"
@@ -10,7 +9,7 @@
 namespace linq {
 
 template <typename Source>
-class concat_enumerable : public enumerable<typename concat_traits<Source>::inner_value_type>
+class concat_enumerable
 {
 public:
 	typedef concat_enumerator<typename Source::enumerator_type> enumerator_type;
@@ -38,11 +37,6 @@ public:
 		enumerator_type e(std::move(source.get_enumerator()));
 		return e;
 	}
-
-	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
-	{
-		return make_unique<enumerator_type>(std::move(get_enumerator()));
-	}
 };
 
 }
\ No newline at end of file
@@ -8,7 +8,7 @@
 namespace linq {
 
 template <typename Source>
-class concat_enumerator : public enumerator<typename concat_traits<Source>::inner_value_type>
+class concat_enumerator
 {
 public:
 	typedef typename concat_traits<Source>::inner_value_type value_type;
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Optional extension of random access enumerators (see random_access_traits.h): contiguous storage
+// o &e.at(i) == &e.at(0) + i for every i < size(), so a fresh enumerator's values can be read as one array
+// o Enumerators opt in by specializing contiguous_traits with is_contiguous == true
+
+namespace linq {
+
+template <typename Enumerator>
+struct contiguous_traits
+{
+	static const bool is_contiguous = false;
+};
+
+//pointers, and the iterators of std::vector (but not std::vector<bool>), std::string and std::wstring
+template <typename Iterator>
+struct is_contiguous_iterator
+{
+private:
+	typedef typename std::remove_cv<typename std::iterator_traits<Iterator>::value_type>::type value_type;
+
+public:
+	static const bool value = !std::is_same<value_type, bool>::value && (
+		std::is_pointer<Iterator>::value ||
+		std::is_same<Iterator, typename std::vector<value_type>::iterator>::value ||
+		std::is_same<Iterator, typename std::vector<value_type>::const_iterator>::value ||
+		std::is_same<Iterator, std::string::iterator>::value ||
+		std::is_same<Iterator, std::string::const_iterator>::value ||
+		std::is_same<Iterator, std::wstring::iterator>::value ||
+		std::is_same<Iterator, std::wstring::const_iterator>::value);
+};
+
+}
\ No newline at end of file
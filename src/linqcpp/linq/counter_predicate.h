@@ -21,6 +21,11 @@ public:
 	{
 		return remaining-- > 0;
 	}
+
+	std::size_t get_remaining() const
+	{
+		return remaining;
+	}
 };
 
 }
\ No newline at end of file
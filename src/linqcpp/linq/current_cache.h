@@ -0,0 +1,112 @@
+#pragma once
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace linq {
+
+// The value_type T of a source's current(), kept by an enumerator that had to look at it, so its own current()
+// hands it back instead of evaluating the source again
+// o A reference is kept as a pointer to what it refers to; a value is moved into storage within the cache, so it
+//   need not be default constructible
+template <typename T, bool IsReference = std::is_reference<T>::value>
+class current_cache;
+
+template <typename T>
+class current_cache<T, true>
+{
+private:
+	typename std::remove_reference<T>::type* pointer;
+
+	current_cache(current_cache const&); // not defined
+	current_cache& operator=(current_cache const&); // not defined
+
+public:
+	current_cache()
+		: pointer(nullptr)
+	{
+	}
+
+	current_cache(current_cache&& other)
+		: pointer(other.pointer)
+	{
+	}
+
+	//value must stay valid until the next set (as a source's current() does until its next move)
+	T set(T value)
+	{
+		pointer = std::addressof(value);
+		return static_cast<T>(*pointer);
+	}
+
+	T get()
+	{
+		return static_cast<T>(*pointer);
+	}
+};
+
+template <typename T>
+class current_cache<T, false>
+{
+private:
+	typedef typename std::remove_cv<T>::type stored_type;
+
+	typename std::aligned_storage<sizeof(stored_type), std::alignment_of<stored_type>::value>::type storage;
+	bool has_value;
+
+	current_cache(current_cache const&); // not defined
+	current_cache& operator=(current_cache const&); // not defined
+
+	stored_type& value()
+	{
+		return *reinterpret_cast<stored_type*>(&storage);
+	}
+
+	void reset()
+	{
+		if (has_value)
+		{
+			value().~stored_type();
+			has_value = false;
+		}
+	}
+
+public:
+	current_cache()
+		: has_value(false)
+	{
+	}
+
+	current_cache(current_cache&& other)
+		: has_value(false)
+	{
+		if (other.has_value)
+		{
+			new (&storage) stored_type(std::move(other.value()));
+			has_value = true;
+		}
+	}
+
+	~current_cache()
+	{
+		reset();
+	}
+
+	stored_type const& set(stored_type&& value)
+	{
+		reset();
+		new (&storage) stored_type(std::move(value));
+		has_value = true;
+		return this->value();
+	}
+
+	//a copy, as current() may be called more than once
+	T get()
+	{
+		return value();
+	}
+};
+
+}
\ No newline at end of file
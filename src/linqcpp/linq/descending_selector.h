@@ -0,0 +1,44 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+namespace linq {
+
+// A sort key that orders in reverse, as selected by order_by_descending and then_by_descending
+template <typename Key>
+struct descending_key
+{
+	Key key;
+
+	descending_key(Key key)
+		: key(std::move(key))
+	{
+	}
+
+	bool operator<(descending_key const& other) const
+	{
+		return other.key < key;
+	}
+};
+
+template <typename T, typename Selector>
+class descending_selector
+{
+private:
+	Selector selector;
+public:
+	typedef typename std::decay<decltype(std::declval<Selector&>()(std::declval<T const&>()))>::type key_type;
+
+	descending_selector(Selector const& selector)
+		: selector(selector)
+	{
+	}
+
+	descending_key<key_type> operator()(T const& value)
+	{
+		return descending_key<key_type>(selector(value));
+	}
+};
+
+}
\ No newline at end of file
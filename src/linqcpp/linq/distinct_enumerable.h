@@ -0,0 +1,79 @@
+#pragma once
+
+#include "enumerable.h"
+#include "size_hint.h"
+#include "memory_resource.h"
+#include "push_traits.h"
+#include "flat_hash.h"
+#include "distinct_enumerator.h"
+
+namespace linq {
+
+// The values of Source with distinct keys (the first value with each key), lazily and in source order
+template <typename Source, typename KeySelector, typename Hash>
+class distinct_enumerable
+{
+public:
+	typedef distinct_enumerator<typename Source::enumerator_type, KeySelector, Hash> enumerator_type;
+	typedef typename enumerator_type::value_type value_type;
+	typedef typename enumerator_type::key_type key_type;
+
+private:
+	Source source;
+	KeySelector key_selector;
+	Hash hash;
+	memory_resource* resource;
+
+	distinct_enumerable(distinct_enumerable const&); // not defined
+	distinct_enumerable& operator=(distinct_enumerable const&); // not defined
+
+public:
+	distinct_enumerable(distinct_enumerable&& other)
+		: source(std::move(other.source))
+		, key_selector(std::move(other.key_selector))
+		, hash(std::move(other.hash))
+		, resource(other.resource)
+	{
+	}
+
+	distinct_enumerable(Source&& source, KeySelector const& key_selector, Hash const& hash)
+		: source(std::move(source))
+		, key_selector(key_selector)
+		, hash(hash)
+		, resource(new_delete_resource())
+	{
+	}
+
+	enumerator_type get_enumerator()
+	{
+		return enumerator_type(source.get_enumerator(), key_selector, hash, resource);
+	}
+
+	//keeps the seen keys in memory from resource
+	void set_memory_resource(memory_resource& resource)
+	{
+		this->resource = &resource;
+	}
+
+	size_hint get_size_hint()
+	{
+		size_hint hint = linq::get_size_hint(source);
+		return hint.is_exact() && hint.size() <= 1 ? hint : hint.loosen();
+	}
+
+	template <typename Sink>
+	bool push(Sink& sink)
+	{
+		KeySelector key_selector = this->key_selector;
+		flat_hash_index<key_type, Hash> seen(hash, std::equal_to<key_type>(), resource);
+		auto distinct_sink = [&](value_type value) -> bool
+		{
+			if (!seen.insert(key_selector(value)).second)
+				return true;
+			return sink(std::forward<value_type>(value));
+		};
+		return linq::push(source, distinct_sink);
+	}
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "enumerator.h"
+#include "current_cache.h"
+#include "memory_resource.h"
+#include "flat_hash.h"
+#include "lookup.h"
+
+namespace linq {
+
+// Skips the values of Source whose key (as KeySelector selects it) has been seen before
+// o Keys seen so far are kept in a flat_hash_index, so memory grows with the number of distinct keys only
+template <typename Source, typename KeySelector, typename Hash>
+class distinct_enumerator
+{
+public:
+	typedef typename Source::value_type value_type;
+	typedef typename selected_key<KeySelector, typename std::decay<value_type>::type>::type key_type;
+
+private:
+	Source source;
+	KeySelector key_selector;
+	flat_hash_index<key_type, Hash> seen;
+	//the value whose key was inserted last, handed back by current
+	current_cache<value_type> value;
+
+	distinct_enumerator(distinct_enumerator const&); // not defined
+	distinct_enumerator& operator=(distinct_enumerator const&); // not defined
+
+	//moves to the first value from the current one on with an unseen key
+	bool skip_seen()
+	{
+		while (!seen.insert(key_selector(value.set(source.current()))).second)
+		{
+			if (!source.move_next())
+				return false;
+		}
+		return true;
+	}
+
+public:
+	distinct_enumerator(distinct_enumerator&& other)
+		: source(std::move(other.source))
+		, key_selector(std::move(other.key_selector))
+		, seen(std::move(other.seen))
+		, value(std::move(other.value))
+	{
+	}
+
+	distinct_enumerator(Source&& source, KeySelector const& key_selector, Hash const& hash, memory_resource* resource = new_delete_resource())
+		: source(std::move(source))
+		, key_selector(key_selector)
+		, seen(hash, std::equal_to<key_type>(), resource)
+		, value()
+	{
+	}
+
+	bool move_first()
+	{
+		return source.move_first() && skip_seen();
+	}
+
+	bool move_next()
+	{
+		return source.move_next() && skip_seen();
+	}
+
+	value_type current()
+	{
+		return value.get();
+	}
+};
+
+}
\ No newline at end of file
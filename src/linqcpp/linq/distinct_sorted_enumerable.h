@@ -0,0 +1,65 @@
+#pragma once
+
+#include <type_traits>
+
+#include "enumerable.h"
+#include "size_hint.h"
+#include "push_traits.h"
+#include "distinct_sorted_enumerator.h"
+
+namespace linq {
+
+// The distinct values of a Source sorted so that equal values are adjacent, comparing each value with the one before
+template <typename Source>
+class distinct_sorted_enumerable
+{
+public:
+	typedef distinct_sorted_enumerator<typename Source::enumerator_type> enumerator_type;
+	typedef typename enumerator_type::value_type value_type;
+
+private:
+	Source source;
+
+	distinct_sorted_enumerable(distinct_sorted_enumerable const&); // not defined
+	distinct_sorted_enumerable& operator=(distinct_sorted_enumerable const&); // not defined
+
+public:
+	distinct_sorted_enumerable(distinct_sorted_enumerable&& other)
+		: source(std::move(other.source))
+	{
+	}
+
+	distinct_sorted_enumerable(Source&& source)
+		: source(std::move(source))
+	{
+	}
+
+	enumerator_type get_enumerator()
+	{
+		return enumerator_type(source.get_enumerator());
+	}
+
+	size_hint get_size_hint()
+	{
+		size_hint hint = linq::get_size_hint(source);
+		return hint.is_exact() && hint.size() <= 1 ? hint : hint.loosen();
+	}
+
+	template <typename Sink>
+	bool push(Sink& sink)
+	{
+		typename std::decay<value_type>::type previous = typename std::decay<value_type>::type();
+		bool first = true;
+		auto distinct_sink = [&](value_type value) -> bool
+		{
+			if (!first && value == previous)
+				return true;
+			first = false;
+			previous = value;
+			return sink(std::forward<value_type>(value));
+		};
+		return linq::push(source, distinct_sink);
+	}
+};
+
+}
\ No newline at end of file
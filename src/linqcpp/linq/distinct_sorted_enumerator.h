@@ -0,0 +1,94 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "enumerator.h"
+
+namespace linq {
+
+// Skips the values of a sorted Source that are equal (==) to the value before them
+// o Only the last value enumerated is kept, so memory is constant
+template <typename Source>
+class distinct_sorted_enumerator
+{
+public:
+	typedef typename Source::value_type value_type;
+
+private:
+	Source source;
+	//a copy of the value last enumerated, to compare with; it is also what current hands back, unless value_type is a
+	//reference, in which case that is kept in current_pointer
+	typename std::decay<value_type>::type previous;
+	typename std::remove_reference<value_type>::type* current_pointer;
+
+	distinct_sorted_enumerator(distinct_sorted_enumerator const&); // not defined
+	distinct_sorted_enumerator& operator=(distinct_sorted_enumerator const&); // not defined
+
+public:
+	distinct_sorted_enumerator(distinct_sorted_enumerator&& other)
+		: source(std::move(other.source))
+		, previous(std::move(other.previous))
+		, current_pointer(other.current_pointer)
+	{
+	}
+
+	distinct_sorted_enumerator(Source&& source)
+		: source(std::move(source))
+		, previous()
+		, current_pointer(nullptr)
+	{
+	}
+
+	bool move_first()
+	{
+		if (!source.move_first())
+			return false;
+		remember(source.current(), std::is_reference<value_type>());
+		return true;
+	}
+
+	bool move_next()
+	{
+		while (source.move_next())
+		{
+			value_type value = source.current();
+			if (!(value == previous))
+			{
+				remember(std::forward<value_type>(value), std::is_reference<value_type>());
+				return true;
+			}
+		}
+		return false;
+	}
+
+	value_type current()
+	{
+		return current(std::is_reference<value_type>());
+	}
+
+private:
+	void remember(value_type value, std::true_type)
+	{
+		current_pointer = std::addressof(value);
+		previous = value;
+	}
+
+	void remember(value_type value, std::false_type)
+	{
+		previous = std::move(value);
+	}
+
+	value_type current(std::true_type)
+	{
+		return static_cast<value_type>(*current_pointer);
+	}
+
+	value_type current(std::false_type)
+	{
+		return previous;
+	}
+};
+
+}
\ No newline at end of file
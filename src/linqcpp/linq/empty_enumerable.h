@@ -1,13 +1,13 @@
 #pragma once
 
-#include "make_unique.h"
 #include "enumerable.h"
+#include "size_hint.h"
 #include "empty_enumerator.h"
 
 namespace linq {
 
 template <typename T>
-class empty_enumerable : public enumerable<T>
+class empty_enumerable
 {
 public:
 	typedef empty_enumerator<T> enumerator_type;
@@ -18,9 +18,9 @@ public:
 		return enumerator_type();
 	}
 
-	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
+	size_hint get_size_hint()
 	{
-		return make_unique<enumerator_type>(std::move(get_enumerator()));
+		return size_hint::exact(0);
 	}
 };
 
@@ -7,7 +7,7 @@
 namespace linq {
 
 template <typename T>
-class empty_enumerator : public enumerator<T>
+class empty_enumerator
 {
 public:
 	typedef T value_type;
@@ -3,6 +3,7 @@
 #include <memory>
 
 #include "enumerator.h"
+#include "captured_enumerator.h"
 
 // Concept Enumerable<T>
 // o Implies:
@@ -17,13 +18,20 @@
 
 namespace linq {
 
-// Does not (have to) implement concept Enumerable<T> - but inheriting types should
+// The type erased interface of Enumerable<T>, implemented by erased_enumerable (see interactive::ref_count)
+// o The enumerables of a statically typed pipeline do not inherit from it
 template <typename T>
 class enumerable
 {
 public:
 	typedef T value_type;
 	virtual std::unique_ptr<enumerator<value_type>> get_enumerator_ptr() = 0;
+
+	//overridden by erased_enumerable, to store small enumerators inline
+	virtual captured_enumerator<value_type> get_captured_enumerator()
+	{
+		return captured_enumerator<value_type>(get_enumerator_ptr());
+	}
 };
 
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 // Concept Enumerator<T>
 // o Implies:
@@ -18,15 +21,57 @@
 
 namespace linq {
 
-// Does not (have to) implement concept Enumerator<T> - but inheriting types should
+// The type erased interface of Enumerator<T>, implemented by erased_enumerator
+// o The enumerators of a statically typed pipeline do not inherit from it, so calls between them are not virtual
+// o next_batch fills a buffer per virtual call, like batch_traits' next_batch (and with the same rules); by default
+//   through move_first/move_next/current, overridden by erased_enumerator for natively batched enumerators
 template <typename T>
 class enumerator
 {
 public:
 	typedef T value_type;
+	typedef typename std::decay<T>::type batch_type;
+
+private:
+	bool started;
+	bool exhausted;
+
+	std::size_t read_batch(batch_type* buffer, std::size_t capacity, std::true_type)
+	{
+		std::size_t count = 0;
+		while (count < capacity && !exhausted)
+		{
+			exhausted = !(started ? move_next() : move_first());
+			started = true;
+			if (!exhausted)
+			{
+				buffer[count++] = current();
+			}
+		}
+		return count;
+	}
+
+	std::size_t read_batch(batch_type*, std::size_t, std::false_type)
+	{
+		throw new std::logic_error("next_batch called on an enumerator of values that cannot be assigned");
+	}
+
+public:
+	enumerator()
+		: started(false)
+		, exhausted(false)
+	{
+	}
+
+	virtual ~enumerator() {}
 	virtual bool move_first() = 0;
 	virtual bool move_next() = 0;
 	virtual value_type current() = 0;
+
+	virtual std::size_t next_batch(batch_type* buffer, std::size_t capacity)
+	{
+		return read_batch(buffer, capacity, std::integral_constant<bool, std::is_assignable<batch_type&, value_type>::value>());
+	}
 };
 
 template <typename Enumerator>
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <utility>
+
+#include "enumerable.h"
+#include "erased_enumerator.h"
+#include "captured_enumerator.h"
+#include "make_unique.h"
+
+namespace linq {
+
+// An Enumerable<T> behind the type erased enumerable<T> interface, as interactive::ref_count and capture make it
+// o The only place a pipeline meets a virtual call: its enumerators are wrapped in an erased_enumerator
+// o get_captured_enumerator moves the concrete enumerator into the captured_enumerator, inline if it is small
+template <typename Enumerable>
+class erased_enumerable : public enumerable<typename Enumerable::value_type>
+{
+public:
+	typedef typename Enumerable::value_type value_type;
+
+private:
+	Enumerable source;
+
+	erased_enumerable(erased_enumerable const&); // not defined
+	erased_enumerable& operator=(erased_enumerable const&); // not defined
+
+public:
+	erased_enumerable(Enumerable&& source)
+		: source(std::move(source))
+	{
+	}
+
+	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
+	{
+		return make_unique<erased_enumerator<typename Enumerable::enumerator_type>>(std::move(source.get_enumerator()));
+	}
+
+	captured_enumerator<value_type> get_captured_enumerator()
+	{
+		return captured_enumerator<value_type>(source.get_enumerator());
+	}
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "enumerator.h"
+#include "batch_traits.h"
+
+namespace linq {
+
+// An Enumerator<T> behind the type erased enumerator<T> interface, as erased_enumerable and captured_enumerator
+// hand it out
+// o next_batch forwards to the enumerator's own if it is batched, so a batch costs one virtual call
+template <typename Enumerator>
+class erased_enumerator : public enumerator<typename Enumerator::value_type>
+{
+public:
+	typedef typename Enumerator::value_type value_type;
+
+private:
+	Enumerator source;
+
+	erased_enumerator(erased_enumerator const&); // not defined
+	erased_enumerator& operator=(erased_enumerator const&); // not defined
+
+	typedef typename enumerator<value_type>::batch_type batch_type;
+
+	std::size_t next_batch(batch_type* buffer, std::size_t capacity, std::true_type)
+	{
+		return source.next_batch(buffer, capacity);
+	}
+
+	std::size_t next_batch(batch_type* buffer, std::size_t capacity, std::false_type)
+	{
+		return enumerator<value_type>::next_batch(buffer, capacity);
+	}
+
+public:
+	erased_enumerator(erased_enumerator&& other)
+		: source(std::move(other.source))
+	{
+	}
+
+	erased_enumerator(Enumerator&& source)
+		: source(std::move(source))
+	{
+	}
+
+	bool move_first()
+	{
+		return source.move_first();
+	}
+
+	bool move_next()
+	{
+		return source.move_next();
+	}
+
+	value_type current()
+	{
+		return source.current();
+	}
+
+	std::size_t next_batch(batch_type* buffer, std::size_t capacity)
+	{
+		return next_batch(buffer, capacity, std::integral_constant<bool, batch_traits<Enumerator>::is_batched>());
+	}
+};
+
+}
\ No newline at end of file
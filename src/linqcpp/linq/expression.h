@@ -0,0 +1,487 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "simd_kernels.h"
+
+// Placeholder expressions: predicates and selectors written in terms of the placeholder _1, e.g.
+// _1 > 5 && _1 % 3 == 0, or (_1->*&person::age) * 12
+// o Callable with one argument like a lambda, so usable wherever one is accepted
+// o Arithmetic, bitwise, comparison and logical operators; && and || short circuit like the built in ones
+// o ->* with a pointer to data member reads that member (.* cannot be overloaded)
+// o Expressions whose values are all arithmetic (reading members of trivially copyable arguments) are also block
+//   evaluable: the whole expression is inlined into one branch-free loop over a block of values, compiled for
+//   each instruction set and dispatched at runtime like the kernels of simd_kernels.h; where and select evaluate
+//   them a block at a time over batched sources. There && and || evaluate both sides and combine them without
+//   branching, unless the right side divides (/ or %), which could trap for a value the left side rules out
+// o Constants are values of the expression, not of the code, so dividing by one is a real division
+
+// Optional extension of function objects: evaluation over arrays
+// o block_evaluation_traits<Function, Arg>::is_block_evaluable == true
+// o typename block_evaluation_traits<Function, Arg>::result_type: the type of function(arg)
+// o typename block_evaluation_traits<Function, Arg>::lane_type: result_type, but unsigned char (0 or 1) for bool
+// o void function.evaluate(Arg const* data, std::size_t size, lane_type* out) const
+//   o Writes the value of data[i] to out[i], for each i < size
+
+namespace linq {
+
+template <typename Function, typename Arg, typename Enable = void>
+struct block_evaluation_traits
+{
+	typedef void result_type;
+	typedef void lane_type;
+	static const bool is_block_evaluable = false;
+};
+
+namespace expression_detail {
+
+	template <typename T>
+	struct lane
+	{
+		typedef T type;
+	};
+
+	template <>
+	struct lane<bool>
+	{
+		typedef unsigned char type;
+	};
+
+	//the value of node for an argument of type Arg
+	template <typename Node, typename Arg>
+	struct result
+	{
+		typedef typename std::decay<decltype(std::declval<Node const&>()(std::declval<Arg const&>()))>::type type;
+	};
+
+	// Concept Node: a node of an expression
+	// o operator()(Arg const& argument) const: the value of the node for argument
+	// o block_value(Arg const& argument) const: the same value, as block evaluation computes it (see logical_node)
+	// o template <typename Arg> struct is_vectorizable { static const bool value; }
+	//   o Whether the node's value, and those of the nodes below it, are arithmetic for an argument of type Arg
+	// o static const bool may_trap: whether evaluating the node, or a node below it, may trap (divides)
+
+	struct argument_node
+	{
+		template <typename Arg>
+		struct is_vectorizable
+		{
+			static const bool value = std::is_trivially_copyable<Arg>::value && !std::is_same<Arg, bool>::value;
+		};
+
+		static const bool may_trap = false;
+
+		template <typename Arg>
+		Arg const& operator()(Arg const& argument) const
+		{
+			return argument;
+		}
+
+		template <typename Arg>
+		Arg const& block_value(Arg const& argument) const
+		{
+			return argument;
+		}
+	};
+
+	template <typename T>
+	struct constant_node
+	{
+		T value;
+
+		explicit constant_node(T const& value)
+			: value(value)
+		{
+		}
+
+		template <typename Arg>
+		struct is_vectorizable
+		{
+			static const bool value = std::is_arithmetic<T>::value;
+		};
+
+		static const bool may_trap = false;
+
+		template <typename Arg>
+		T const& operator()(Arg const&) const
+		{
+			return value;
+		}
+
+		template <typename Arg>
+		T const& block_value(Arg const&) const
+		{
+			return value;
+		}
+	};
+
+	template <typename Object, typename Class, typename Member>
+	struct member_node
+	{
+		Object object;
+		Member Class::* member;
+
+		member_node(Object const& object, Member Class::* member)
+			: object(object)
+			, member(member)
+		{
+		}
+
+		template <typename Arg>
+		struct is_vectorizable
+		{
+			static const bool value = Object::template is_vectorizable<Arg>::value && std::is_arithmetic<Member>::value;
+		};
+
+		static const bool may_trap = Object::may_trap;
+
+		//a reference to the member if the object is a reference, or else a copy
+		template <typename Arg>
+		typename std::conditional<std::is_reference<decltype(std::declval<Object const&>()(std::declval<Arg const&>()))>::value, Member const&, Member>::type
+		operator()(Arg const& argument) const
+		{
+			return object(argument).*member;
+		}
+
+		template <typename Arg>
+		typename std::conditional<std::is_reference<decltype(std::declval<Object const&>()(std::declval<Arg const&>()))>::value, Member const&, Member>::type
+		block_value(Arg const& argument) const
+		{
+			return object.block_value(argument).*member;
+		}
+	};
+
+	template <typename Op, typename Operand>
+	struct unary_node
+	{
+		Operand operand;
+
+		explicit unary_node(Operand const& operand)
+			: operand(operand)
+		{
+		}
+
+		template <typename Arg>
+		struct is_vectorizable
+		{
+			static const bool value = Operand::template is_vectorizable<Arg>::value && std::is_arithmetic<typename result<unary_node, Arg>::type>::value;
+		};
+
+		static const bool may_trap = Operand::may_trap;
+
+		template <typename Arg>
+		auto operator()(Arg const& argument) const -> decltype(Op::apply(std::declval<Operand const&>()(argument)))
+		{
+			return Op::apply(operand(argument));
+		}
+
+		template <typename Arg>
+		auto block_value(Arg const& argument) const -> decltype(Op::apply(std::declval<Operand const&>()(argument)))
+		{
+			return Op::apply(operand.block_value(argument));
+		}
+	};
+
+	template <typename Op, typename Left, typename Right>
+	struct binary_node
+	{
+		Left left;
+		Right right;
+
+		binary_node(Left const& left, Right const& right)
+			: left(left)
+			, right(right)
+		{
+		}
+
+		template <typename Arg>
+		struct is_vectorizable
+		{
+			static const bool value =
+				Left::template is_vectorizable<Arg>::value &&
+				Right::template is_vectorizable<Arg>::value &&
+				std::is_arithmetic<typename result<binary_node, Arg>::type>::value;
+		};
+
+		static const bool may_trap = Op::may_trap || Left::may_trap || Right::may_trap;
+
+		template <typename Arg>
+		auto operator()(Arg const& argument) const -> decltype(Op::apply(std::declval<Left const&>()(argument), std::declval<Right const&>()(argument)))
+		{
+			return Op::apply(left(argument), right(argument));
+		}
+
+		template <typename Arg>
+		auto block_value(Arg const& argument) const -> decltype(Op::apply(std::declval<Left const&>()(argument), std::declval<Right const&>()(argument)))
+		{
+			return Op::apply(left.block_value(argument), right.block_value(argument));
+		}
+	};
+
+	//&& and ||: short circuits, except in block evaluation when the right side cannot trap
+	template <typename Op, typename Left, typename Right>
+	struct logical_node
+	{
+		Left left;
+		Right right;
+
+		logical_node(Left const& left, Right const& right)
+			: left(left)
+			, right(right)
+		{
+		}
+
+		template <typename Arg>
+		struct is_vectorizable
+		{
+			static const bool value = Left::template is_vectorizable<Arg>::value && Right::template is_vectorizable<Arg>::value;
+		};
+
+		static const bool may_trap = Left::may_trap || Right::may_trap;
+
+		template <typename Arg>
+		bool operator()(Arg const& argument) const
+		{
+			bool value = static_cast<bool>(left(argument));
+			if (Op::is_decided_by(value))
+				return value;
+			return static_cast<bool>(right(argument));
+		}
+
+		template <typename Arg>
+		bool block_value(Arg const& argument) const
+		{
+			return block_value(argument, std::integral_constant<bool, Right::may_trap>());
+		}
+
+	private:
+		template <typename Arg>
+		bool block_value(Arg const& argument, std::true_type) const
+		{
+			bool value = static_cast<bool>(left.block_value(argument));
+			if (Op::is_decided_by(value))
+				return value;
+			return static_cast<bool>(right.block_value(argument));
+		}
+
+		template <typename Arg>
+		bool block_value(Arg const& argument, std::false_type) const
+		{
+			return Op::apply(static_cast<bool>(left.block_value(argument)), static_cast<bool>(right.block_value(argument)));
+		}
+	};
+
+#define LINQ_EXPRESSION_UNARY_OP(name, op) \
+	struct name \
+	{ \
+		static const bool may_trap = false; \
+		\
+		template <typename T> \
+		static auto apply(T const& value) -> decltype(op value) \
+		{ \
+			return op value; \
+		} \
+	};
+
+#define LINQ_EXPRESSION_BINARY_OP(name, op, traps) \
+	struct name \
+	{ \
+		static const bool may_trap = traps; \
+		\
+		template <typename L, typename R> \
+		static auto apply(L const& left, R const& right) -> decltype(left op right) \
+		{ \
+			return left op right; \
+		} \
+	};
+
+	LINQ_EXPRESSION_UNARY_OP(negate_op, -)
+	LINQ_EXPRESSION_UNARY_OP(complement_op, ~)
+	LINQ_EXPRESSION_UNARY_OP(not_op, !)
+
+	LINQ_EXPRESSION_BINARY_OP(plus_op, +, false)
+	LINQ_EXPRESSION_BINARY_OP(minus_op, -, false)
+	LINQ_EXPRESSION_BINARY_OP(multiplies_op, *, false)
+	LINQ_EXPRESSION_BINARY_OP(divides_op, /, true)
+	LINQ_EXPRESSION_BINARY_OP(modulus_op, %, true)
+	LINQ_EXPRESSION_BINARY_OP(bit_and_op, &, false)
+	LINQ_EXPRESSION_BINARY_OP(bit_or_op, |, false)
+	LINQ_EXPRESSION_BINARY_OP(bit_xor_op, ^, false)
+	LINQ_EXPRESSION_BINARY_OP(equal_op, ==, false)
+	LINQ_EXPRESSION_BINARY_OP(not_equal_op, !=, false)
+	LINQ_EXPRESSION_BINARY_OP(less_op, <, false)
+	LINQ_EXPRESSION_BINARY_OP(less_equal_op, <=, false)
+	LINQ_EXPRESSION_BINARY_OP(greater_op, >, false)
+	LINQ_EXPRESSION_BINARY_OP(greater_equal_op, >=, false)
+
+#undef LINQ_EXPRESSION_UNARY_OP
+#undef LINQ_EXPRESSION_BINARY_OP
+
+	//apply combines both sides without branching; is_decided_by tells when the left side alone decides the value
+	struct logical_and_op
+	{
+		static bool apply(bool left, bool right)
+		{
+			return left & right;
+		}
+
+		static bool is_decided_by(bool left)
+		{
+			return !left;
+		}
+	};
+
+	struct logical_or_op
+	{
+		static bool apply(bool left, bool right)
+		{
+			return left | right;
+		}
+
+		static bool is_decided_by(bool left)
+		{
+			return left;
+		}
+	};
+
+	//one branch-free loop over the block, with the whole expression inlined into it; the node is copied to a local,
+	//so the compiler knows stores to out (which may be unsigned char, and alias anything) leave its constants alone
+	template <typename Node, typename Arg, typename Lane>
+	void evaluate(Node const& node, Arg const* data, std::size_t size, Lane* out)
+	{
+		Node const local = node;
+		for (std::size_t i = 0; i < size; ++i)
+			out[i] = local.block_value(data[i]);
+	}
+
+#if LINQ_SIMD_X86
+	//the same loop, vectorized for AVX2
+	template <typename Node, typename Arg, typename Lane>
+	LINQ_TARGET_AVX2 void evaluate_avx2(Node const& node, Arg const* data, std::size_t size, Lane* out)
+	{
+		Node const local = node;
+		for (std::size_t i = 0; i < size; ++i)
+			out[i] = local.block_value(data[i]);
+	}
+#endif
+
+}
+
+// A placeholder expression: a function object of one argument built from placeholders::_1 and operators
+template <typename Node>
+class expression
+{
+public:
+	Node node;
+
+	expression()
+		: node()
+	{
+	}
+
+	explicit expression(Node const& node)
+		: node(node)
+	{
+	}
+
+	template <typename Arg>
+	typename expression_detail::result<Node, Arg>::type operator()(Arg const& argument) const
+	{
+		return node(argument);
+	}
+
+	template <typename Arg>
+	void evaluate(Arg const* data, std::size_t size, typename block_evaluation_traits<expression, Arg>::lane_type* out) const
+	{
+#if LINQ_SIMD_X86
+		if (simd::active_level() == simd::avx2_level)
+			return expression_detail::evaluate_avx2(node, data, size, out);
+#endif
+		expression_detail::evaluate(node, data, size, out);
+	}
+
+	//reads the data member member of the value
+	template <typename Class, typename Member>
+	typename std::enable_if<!std::is_function<Member>::value, expression<expression_detail::member_node<Node, Class, Member>>>::type
+	operator->*(Member Class::* member) const
+	{
+		return expression<expression_detail::member_node<Node, Class, Member>>(expression_detail::member_node<Node, Class, Member>(node, member));
+	}
+};
+
+template <typename Node, typename Arg>
+struct block_evaluation_traits<expression<Node>, Arg>
+{
+	typedef typename expression_detail::result<Node, Arg>::type result_type;
+	typedef typename expression_detail::lane<result_type>::type lane_type;
+	static const bool is_block_evaluable = Node::template is_vectorizable<Arg>::value;
+};
+
+namespace placeholders {
+
+	static const expression<expression_detail::argument_node> _1;
+
+}
+
+#define LINQ_EXPRESSION_UNARY_OPERATOR(op, name) \
+	template <typename Operand> \
+	expression<expression_detail::unary_node<expression_detail::name, Operand>> operator op(expression<Operand> const& operand) \
+	{ \
+		return expression<expression_detail::unary_node<expression_detail::name, Operand>>( \
+			expression_detail::unary_node<expression_detail::name, Operand>(operand.node)); \
+	}
+
+#define LINQ_EXPRESSION_BINARY_OPERATOR(op, node_template, name) \
+	template <typename Left, typename Right> \
+	expression<expression_detail::node_template<expression_detail::name, Left, Right>> \
+	operator op(expression<Left> const& left, expression<Right> const& right) \
+	{ \
+		return expression<expression_detail::node_template<expression_detail::name, Left, Right>>( \
+			expression_detail::node_template<expression_detail::name, Left, Right>(left.node, right.node)); \
+	} \
+	\
+	template <typename Left, typename Right> \
+	expression<expression_detail::node_template<expression_detail::name, Left, expression_detail::constant_node<typename std::decay<Right const>::type>>> \
+	operator op(expression<Left> const& left, Right const& right) \
+	{ \
+		typedef expression_detail::constant_node<typename std::decay<Right const>::type> constant_type; \
+		return expression<expression_detail::node_template<expression_detail::name, Left, constant_type>>( \
+			expression_detail::node_template<expression_detail::name, Left, constant_type>(left.node, constant_type(right))); \
+	} \
+	\
+	template <typename Left, typename Right> \
+	expression<expression_detail::node_template<expression_detail::name, expression_detail::constant_node<typename std::decay<Left const>::type>, Right>> \
+	operator op(Left const& left, expression<Right> const& right) \
+	{ \
+		typedef expression_detail::constant_node<typename std::decay<Left const>::type> constant_type; \
+		return expression<expression_detail::node_template<expression_detail::name, constant_type, Right>>( \
+			expression_detail::node_template<expression_detail::name, constant_type, Right>(constant_type(left), right.node)); \
+	}
+
+LINQ_EXPRESSION_UNARY_OPERATOR(-, negate_op)
+LINQ_EXPRESSION_UNARY_OPERATOR(~, complement_op)
+LINQ_EXPRESSION_UNARY_OPERATOR(!, not_op)
+
+LINQ_EXPRESSION_BINARY_OPERATOR(+, binary_node, plus_op)
+LINQ_EXPRESSION_BINARY_OPERATOR(-, binary_node, minus_op)
+LINQ_EXPRESSION_BINARY_OPERATOR(*, binary_node, multiplies_op)
+LINQ_EXPRESSION_BINARY_OPERATOR(/, binary_node, divides_op)
+LINQ_EXPRESSION_BINARY_OPERATOR(%, binary_node, modulus_op)
+LINQ_EXPRESSION_BINARY_OPERATOR(&, binary_node, bit_and_op)
+LINQ_EXPRESSION_BINARY_OPERATOR(|, binary_node, bit_or_op)
+LINQ_EXPRESSION_BINARY_OPERATOR(^, binary_node, bit_xor_op)
+LINQ_EXPRESSION_BINARY_OPERATOR(==, binary_node, equal_op)
+LINQ_EXPRESSION_BINARY_OPERATOR(!=, binary_node, not_equal_op)
+LINQ_EXPRESSION_BINARY_OPERATOR(<, binary_node, less_op)
+LINQ_EXPRESSION_BINARY_OPERATOR(<=, binary_node, less_equal_op)
+LINQ_EXPRESSION_BINARY_OPERATOR(>, binary_node, greater_op)
+LINQ_EXPRESSION_BINARY_OPERATOR(>=, binary_node, greater_equal_op)
+LINQ_EXPRESSION_BINARY_OPERATOR(&&, logical_node, logical_and_op)
+LINQ_EXPRESSION_BINARY_OPERATOR(||, logical_node, logical_or_op)
+
+#undef LINQ_EXPRESSION_UNARY_OPERATOR
+#undef LINQ_EXPRESSION_BINARY_OPERATOR
+
+}
\ No newline at end of file
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "memory_resource.h"
+#include "loser_tree.h"
+
+// Concept Serializer<T>: how order_by spills values of type T to temporary files (see sort_policy::memory_budget)
+// o static const bool is_serializable = true
+// o static void write(std::FILE* file, T const& value)
+// o static T read(std::FILE* file)
+//   o Reads back a value written by write
+// o Both throw std::runtime_error if the file cannot be written or read
+// o spill_serializer<T> provides a binary format for trivially copyable types, std::string and std::pair of those;
+//   specialize it for other types
+
+namespace linq {
+
+template <typename T, typename Enable = void>
+struct spill_serializer
+{
+	static const bool is_serializable = false;
+};
+
+namespace spill_detail {
+
+	inline void write_bytes(std::FILE* file, void const* bytes, std::size_t size)
+	{
+		if (size != 0 && std::fwrite(bytes, size, 1, file) != 1)
+			throw std::runtime_error("could not write a sorted run to a temporary file");
+	}
+
+	inline void read_bytes(std::FILE* file, void* bytes, std::size_t size)
+	{
+		if (size != 0 && std::fread(bytes, size, 1, file) != 1)
+			throw std::runtime_error("could not read a sorted run back from a temporary file");
+	}
+
+}
+
+//the object representation, as it is
+template <typename T>
+struct spill_serializer<T, typename std::enable_if<std::is_trivially_copyable<T>::value>::type>
+{
+	static const bool is_serializable = true;
+
+	static void write(std::FILE* file, T const& value)
+	{
+		spill_detail::write_bytes(file, &value, sizeof(T));
+	}
+
+	static T read(std::FILE* file)
+	{
+		typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type storage;
+		spill_detail::read_bytes(file, &storage, sizeof(T));
+		return *reinterpret_cast<T*>(&storage);
+	}
+};
+
+//the length, then the characters
+template <>
+struct spill_serializer<std::string>
+{
+	static const bool is_serializable = true;
+
+	static void write(std::FILE* file, std::string const& value)
+	{
+		std::uint64_t size = value.size();
+		spill_detail::write_bytes(file, &size, sizeof(size));
+		spill_detail::write_bytes(file, value.data(), value.size());
+	}
+
+	static std::string read(std::FILE* file)
+	{
+		std::uint64_t size;
+		spill_detail::read_bytes(file, &size, sizeof(size));
+		std::string value(static_cast<std::size_t>(size), '\0');
+		if (size != 0)
+			spill_detail::read_bytes(file, &value[0], value.size());
+		return value;
+	}
+};
+
+template <typename First, typename Second>
+struct spill_serializer<std::pair<First, Second>, typename std::enable_if<
+	!std::is_trivially_copyable<std::pair<First, Second>>::value
+	&& spill_serializer<First>::is_serializable
+	&& spill_serializer<Second>::is_serializable>::type>
+{
+	static const bool is_serializable = true;
+
+	static void write(std::FILE* file, std::pair<First, Second> const& value)
+	{
+		spill_serializer<First>::write(file, value.first);
+		spill_serializer<Second>::write(file, value.second);
+	}
+
+	static std::pair<First, Second> read(std::FILE* file)
+	{
+		First first = spill_serializer<First>::read(file);
+		return std::pair<First, Second>(std::move(first), spill_serializer<Second>::read(file));
+	}
+};
+
+// A sorted run written to an anonymous temporary file (removed when closed)
+template <typename T>
+class spill_file
+{
+private:
+	std::FILE* file;
+	std::size_t remaining;
+
+	spill_file(spill_file const&); // not defined
+	spill_file& operator=(spill_file const&); // not defined
+
+public:
+	template <typename Iterator>
+	spill_file(Iterator first, Iterator last)
+		: file(std::tmpfile())
+		, remaining(0)
+	{
+		if (!file)
+			throw std::runtime_error("could not create a temporary file for a sorted run");
+		try
+		{
+			for (; first != last; ++first, ++remaining)
+				spill_serializer<T>::write(file, *first);
+			if (std::fflush(file) != 0)
+				throw std::runtime_error("could not write a sorted run to a temporary file");
+		}
+		catch (...)
+		{
+			std::fclose(file);
+			throw;
+		}
+		std::rewind(file);
+	}
+
+	~spill_file()
+	{
+		std::fclose(file);
+	}
+
+	bool empty() const
+	{
+		return remaining == 0;
+	}
+
+	T read()
+	{
+		--remaining;
+		return spill_serializer<T>::read(file);
+	}
+};
+
+// Merges sorted runs lazily: runs spilled to files, in source order, then a last run kept in memory
+// o Ties go to the earlier run, so merging the stably sorted runs of a source keeps the sort stable
+// o The head of each run is cached, and a loser_tree picks the next one
+template <typename T, typename Compare>
+class spilled_merge
+{
+private:
+	std::vector<std::unique_ptr<spill_file<T>>> files;
+	std::vector<T, resource_allocator<T>> last_run;
+	std::size_t last_run_position;
+	std::vector<T> heads;
+	std::vector<bool> exhausted;
+	loser_tree tree;
+	Compare less;
+
+	spilled_merge(spilled_merge const&); // not defined
+	spilled_merge& operator=(spilled_merge const&); // not defined
+
+	//reads the next value of run into heads[run], or marks the run exhausted
+	void advance(std::size_t run)
+	{
+		if (run < files.size())
+		{
+			if (files[run]->empty())
+				exhausted[run] = true;
+			else
+				heads[run] = files[run]->read();
+		}
+		else if (last_run_position == last_run.size())
+			exhausted[run] = true;
+		else
+			heads[run] = std::move(last_run[last_run_position++]);
+	}
+
+	struct beats_type
+	{
+		spilled_merge* merge;
+
+		bool operator()(std::size_t a, std::size_t b) const
+		{
+			if (merge->exhausted[b])
+				return true;
+			if (merge->exhausted[a])
+				return false;
+			if (a < b)
+				return !merge->less(merge->heads[b], merge->heads[a]);
+			return merge->less(merge->heads[a], merge->heads[b]);
+		}
+	};
+
+public:
+	spilled_merge(Compare const& less)
+		: last_run_position(0)
+		, less(less)
+	{
+	}
+
+	//[first, last) must not be empty
+	template <typename Iterator>
+	void spill(Iterator first, Iterator last)
+	{
+		files.push_back(std::unique_ptr<spill_file<T>>(new spill_file<T>(first, last)));
+	}
+
+	void keep_last_run(std::vector<T, resource_allocator<T>>&& values)
+	{
+		last_run = std::move(values);
+	}
+
+	bool move_first()
+	{
+		for (std::size_t run = 0; run < files.size(); ++run)
+			heads.push_back(files[run]->read());
+		if (!last_run.empty())
+			heads.push_back(std::move(last_run[last_run_position++]));
+		exhausted.assign(heads.size(), false);
+		beats_type beats = { this };
+		tree.build(heads.size(), beats);
+		return !heads.empty();
+	}
+
+	bool move_next()
+	{
+		std::size_t winner = tree.winner();
+		advance(winner);
+		beats_type beats = { this };
+		tree.replay(winner, beats);
+		return !exhausted[tree.winner()];
+	}
+
+	T const& current() const
+	{
+		return heads[tree.winner()];
+	}
+};
+
+}
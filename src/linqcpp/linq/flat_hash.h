@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "memory_resource.h"
+
+namespace linq {
+
+// Open addressing hash index: numbers the distinct keys inserted into it 0, 1, 2, ... in order of first insertion
+// o Slots are (hash, index + 1) pairs in a power of two array, probed linearly and kept at most half full
+// o The keys themselves live in a separate dense vector, in index order
+// o Hash (std::hash<Key> by default) is mixed with a multiplicative step, so weak hashes still spread well
+// o Slots and keys are allocated from a memory_resource (the global heap by default)
+template <typename Key, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class flat_hash_index
+{
+public:
+	static const std::size_t npos = static_cast<std::size_t>(-1);
+
+private:
+	struct slot
+	{
+		std::size_t hash;
+		//index + 1 of the key, or 0 if the slot is empty
+		std::size_t index;
+	};
+
+	static const std::size_t min_slot_count = 16;
+
+	std::vector<slot, resource_allocator<slot>> slots;
+	std::vector<Key, resource_allocator<Key>> keys;
+	unsigned shift;
+	Hash hasher;
+	Equal equal;
+
+	flat_hash_index(flat_hash_index const&); // not defined
+	flat_hash_index& operator=(flat_hash_index const&); // not defined
+
+	std::size_t home(std::size_t hash) const
+	{
+		return static_cast<std::size_t>((static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL) >> shift);
+	}
+
+	void rehash(std::size_t slot_count)
+	{
+		std::vector<slot, resource_allocator<slot>> old_slots(slot_count, slot(), slots.get_allocator());
+		old_slots.swap(slots);
+		shift = 64;
+		for (std::size_t n = slot_count; n > 1; n /= 2)
+			--shift;
+
+		std::size_t mask = slots.size() - 1;
+		for (auto old = old_slots.begin(); old != old_slots.end(); ++old)
+		{
+			if (old->index == 0)
+				continue;
+			std::size_t position = home(old->hash);
+			while (slots[position].index != 0)
+				position = (position + 1) & mask;
+			slots[position] = *old;
+		}
+	}
+
+	//makes room for one more key, then finds key: returns its index, and true if it was not there, in which case a slot
+	//is claimed for it and the caller must push it next
+	std::pair<std::size_t, bool> probe(Key const& key)
+	{
+		if (2 * (keys.size() + 1) > slots.size())
+			rehash(slots.empty() ? min_slot_count : 2 * slots.size());
+
+		std::size_t hash = hasher(key);
+		std::size_t mask = slots.size() - 1;
+		std::size_t position = home(hash);
+		while (slots[position].index != 0)
+		{
+			if (slots[position].hash == hash && equal(keys[slots[position].index - 1], key))
+				return std::make_pair(slots[position].index - 1, false);
+			position = (position + 1) & mask;
+		}
+		slots[position].hash = hash;
+		slots[position].index = keys.size() + 1;
+		return std::make_pair(keys.size(), true);
+	}
+
+public:
+	explicit flat_hash_index(Hash const& hasher = Hash(), Equal const& equal = Equal(), memory_resource* resource = new_delete_resource())
+		: slots(resource)
+		, keys(resource)
+		, shift(64)
+		, hasher(hasher)
+		, equal(equal)
+	{
+	}
+
+	flat_hash_index(flat_hash_index&& other)
+		: slots(std::move(other.slots))
+		, keys(std::move(other.keys))
+		, shift(other.shift)
+		, hasher(std::move(other.hasher))
+		, equal(std::move(other.equal))
+	{
+	}
+
+	flat_hash_index& operator=(flat_hash_index&& other)
+	{
+		slots = std::move(other.slots);
+		keys = std::move(other.keys);
+		shift = other.shift;
+		hasher = std::move(other.hasher);
+		equal = std::move(other.equal);
+		return *this;
+	}
+
+	//makes room for count distinct keys without rehashing
+	void reserve(std::size_t count)
+	{
+		std::size_t slot_count = min_slot_count;
+		while (slot_count < 2 * count)
+			slot_count *= 2;
+		if (slot_count > slots.size())
+			rehash(slot_count);
+		keys.reserve(count);
+	}
+
+	//returns the index of key, and true if it was not in the index before; key is copied only if it is inserted
+	std::pair<std::size_t, bool> insert(Key const& key)
+	{
+		std::pair<std::size_t, bool> result = probe(key);
+		if (result.second)
+			keys.push_back(key);
+		return result;
+	}
+
+	//key is moved from only if it is inserted
+	std::pair<std::size_t, bool> insert(Key&& key)
+	{
+		std::pair<std::size_t, bool> result = probe(key);
+		if (result.second)
+			keys.push_back(std::move(key));
+		return result;
+	}
+
+	//returns the index of key, or npos
+	std::size_t find(Key const& key) const
+	{
+		if (slots.empty())
+			return npos;
+		std::size_t hash = hasher(key);
+		std::size_t mask = slots.size() - 1;
+		for (std::size_t position = home(hash); slots[position].index != 0; position = (position + 1) & mask)
+		{
+			if (slots[position].hash == hash && equal(keys[slots[position].index - 1], key))
+				return slots[position].index - 1;
+		}
+		return npos;
+	}
+
+	std::size_t size() const
+	{
+		return keys.size();
+	}
+
+	Key const& key(std::size_t index) const
+	{
+		return keys[index];
+	}
+};
+
+template <typename Key, typename Hash, typename Equal>
+const std::size_t flat_hash_index<Key, Hash, Equal>::npos;
+
+}
\ No newline at end of file
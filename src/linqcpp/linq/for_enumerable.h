@@ -1,13 +1,12 @@
 #pragma once
 
-#include "make_unique.h"
 #include "enumerable.h"
 #include "for_enumerator.h"
 
 namespace linq {
 
 template <typename T, typename Condition, typename Next>
-class for_enumerable : public enumerable<T>
+class for_enumerable
 {
 public:
 	typedef for_enumerator<T, Condition, Next> enumerator_type;
@@ -37,11 +36,6 @@ public:
 	{
 		return enumerator_type(start, condition, next);
 	}
-
-	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
-	{
-		return make_unique<enumerator_type>(std::move(get_enumerator()));
-	}
 };
 
 }
\ No newline at end of file
@@ -7,7 +7,7 @@
 namespace linq {
 
 template <typename T, typename Condition, typename Next>
-class for_enumerator : public enumerator<T>
+class for_enumerator
 {
 public:
 	typedef T value_type;
@@ -1,14 +1,48 @@
 #pragma once
 
-#include "make_unique.h"
 #include "range_traits.h"
+#include "size_hint.h"
+#include "push_traits.h"
+#include "partition_traits.h"
 #include "enumerable.h"
 #include "from_enumerator.h"
 
 namespace linq {
 
+namespace from_size {
+
+	//ranges with a size() member (std::list, std::set, ...) know their size
+	template <typename Range>
+	auto range_size_hint(Range& range, int) -> decltype(size_hint::exact(range.size()))
+	{
+		return size_hint::exact(range.size());
+	}
+
+	//otherwise a random access range can measure itself in constant time
+	template <typename Range>
+	size_hint range_size_hint(Range& range, std::random_access_iterator_tag)
+	{
+		using std::begin;
+		using std::end;
+		return size_hint::exact(static_cast<std::size_t>(end(range) - begin(range)));
+	}
+
+	template <typename Range>
+	size_hint range_size_hint(Range&, std::input_iterator_tag)
+	{
+		return size_hint::unknown();
+	}
+
+	template <typename Range>
+	size_hint range_size_hint(Range& range, long)
+	{
+		return range_size_hint(range, typename std::iterator_traits<typename range_traits<Range>::iterator_type>::iterator_category());
+	}
+
+}
+
 template <typename Range>
-class from_enumerable : public enumerable<typename from_enumerator<typename range_traits<Range>::iterator_type>::value_type>
+class from_enumerable
 {
 public:
 	typedef from_enumerator<typename range_traits<Range>::iterator_type> enumerator_type;
@@ -22,7 +56,7 @@ private:
 	
 public:
 	from_enumerable(from_enumerable&& other)
-		: range(std::move(other.range))
+		: range(std::forward<Range>(other.range))
 	{
 	}
 
@@ -38,14 +72,41 @@ public:
 		return enumerator_type(begin(range), end(range));
 	}
 
-	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
+	std::size_t partition_size()
+	{
+		using std::begin;
+		using std::end;
+		return static_cast<std::size_t>(end(range) - begin(range));
+	}
+
+	enumerator_type get_partition(std::size_t first, std::size_t last)
+	{
+		using std::begin;
+		return enumerator_type(begin(range) + first, begin(range) + last);
+	}
+
+	size_hint get_size_hint()
+	{
+		return from_size::range_size_hint(range, 0);
+	}
+
+	template <typename Sink>
+	bool push(Sink& sink)
 	{
-		return make_unique<enumerator_type>(std::move(get_enumerator()));
+		using std::begin;
+		using std::end;
+		auto last = end(range);
+		for (auto it = begin(range); it != last; ++it)
+		{
+			if (!sink(*it))
+				return false;
+		}
+		return true;
 	}
 };
 
 template <typename Range>
-class from_enumerable<Range&> : public enumerable<typename from_enumerator<typename range_traits<Range>::iterator_type>::value_type>
+class from_enumerable<Range&>
 {
 public:
 	typedef from_enumerator<typename range_traits<Range>::iterator_type> enumerator_type;
@@ -75,10 +136,45 @@ public:
 		return enumerator_type(begin(range), end(range));
 	}
 
-	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
+	std::size_t partition_size()
+	{
+		using std::begin;
+		using std::end;
+		return static_cast<std::size_t>(end(range) - begin(range));
+	}
+
+	enumerator_type get_partition(std::size_t first, std::size_t last)
+	{
+		using std::begin;
+		return enumerator_type(begin(range) + first, begin(range) + last);
+	}
+
+	size_hint get_size_hint()
+	{
+		return from_size::range_size_hint(range, 0);
+	}
+
+	template <typename Sink>
+	bool push(Sink& sink)
 	{
-		return make_unique<enumerator_type>(std::move(get_enumerator()));
+		using std::begin;
+		using std::end;
+		auto last = end(range);
+		for (auto it = begin(range); it != last; ++it)
+		{
+			if (!sink(*it))
+				return false;
+		}
+		return true;
 	}
 };
 
+template <typename Range>
+struct partition_traits<from_enumerable<Range>>
+{
+	static const bool is_partitionable = std::is_base_of<
+		std::random_access_iterator_tag,
+		typename std::iterator_traits<typename range_traits<Range>::iterator_type>::iterator_category>::value;
+};
+
 }
\ No newline at end of file
@@ -1,13 +1,17 @@
 #pragma once
 
 #include <iterator>
+#include <algorithm>
 
 #include "enumerator.h"
+#include "batch_traits.h"
+#include "random_access_traits.h"
+#include "contiguous_traits.h"
 
 namespace linq {
 
 template <typename Iterator>
-class from_enumerator : public enumerator<typename std::iterator_traits<Iterator>::reference>
+class from_enumerator
 {
 public:
 	typedef typename std::iterator_traits<Iterator>::reference value_type;
@@ -19,6 +23,25 @@ private:
 	from_enumerator(from_enumerator const&); // not defined
 	from_enumerator& operator=(from_enumerator const&); // not defined
 
+	std::size_t next_batch(typename batch_traits<from_enumerator>::batch_type* buffer, std::size_t capacity, std::random_access_iterator_tag)
+	{
+		std::size_t available = static_cast<std::size_t>(end - curr);
+		std::size_t count = capacity < available ? capacity : available;
+		std::copy(curr, curr + count, buffer);
+		curr += count;
+		return count;
+	}
+
+	std::size_t next_batch(typename batch_traits<from_enumerator>::batch_type* buffer, std::size_t capacity, std::input_iterator_tag)
+	{
+		std::size_t count = 0;
+		for (; count < capacity && curr != end; ++count, ++curr)
+		{
+			buffer[count] = *curr;
+		}
+		return count;
+	}
+
 public:
 	from_enumerator(from_enumerator&& other)
 		: curr(std::move(other.curr))
@@ -47,6 +70,47 @@ public:
 	{
 		return *curr;
 	}
+
+	std::size_t next_batch(typename batch_traits<from_enumerator>::batch_type* buffer, std::size_t capacity)
+	{
+		return next_batch(buffer, capacity, typename std::iterator_traits<Iterator>::iterator_category());
+	}
+
+	std::size_t size()
+	{
+		return static_cast<std::size_t>(end - curr);
+	}
+
+	void advance(std::size_t count)
+	{
+		curr += count;
+	}
+
+	value_type at(std::size_t index)
+	{
+		return curr[index];
+	}
+};
+
+template <typename Iterator>
+struct batch_traits<from_enumerator<Iterator>>
+{
+	typedef typename std::decay<typename from_enumerator<Iterator>::value_type>::type batch_type;
+	static const bool is_batched = std::is_trivial<batch_type>::value;
+};
+
+template <typename Iterator>
+struct random_access_traits<from_enumerator<Iterator>>
+{
+	static const bool is_random_access = std::is_base_of<
+		std::random_access_iterator_tag,
+		typename std::iterator_traits<Iterator>::iterator_category>::value;
+};
+
+template <typename Iterator>
+struct contiguous_traits<from_enumerator<Iterator>>
+{
+	static const bool is_contiguous = is_contiguous_iterator<Iterator>::value;
 };
 
 }
\ No newline at end of file
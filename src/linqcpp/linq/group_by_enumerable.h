@@ -0,0 +1,70 @@
+#pragma once
+
+#include <type_traits>
+
+#include "enumerable.h"
+#include "size_hint.h"
+#include "memory_resource.h"
+#include "lookup.h"
+#include "group_by_enumerator.h"
+
+namespace linq {
+
+// Groups the values of Source by the keys KeySelector selects, hashing them with Hash
+// o The whole source is grouped into a lookup by get_enumerator, with one key selection per value
+// o Groups are enumerated in order of first appearance of their keys, each with its values in source order
+template <typename Source, typename KeySelector, typename Hash>
+class group_by_enumerable
+{
+public:
+	typedef typename std::decay<typename Source::value_type>::type element_type;
+	typedef typename selected_key<KeySelector, element_type>::type key_type;
+	typedef group_by_enumerator<key_type, element_type, Hash> enumerator_type;
+	typedef typename enumerator_type::value_type value_type;
+
+private:
+	Source source;
+	KeySelector key_selector;
+	Hash hash;
+	memory_resource* resource;
+
+	group_by_enumerable(group_by_enumerable const&); // not defined
+	group_by_enumerable& operator=(group_by_enumerable const&); // not defined
+
+public:
+	group_by_enumerable(group_by_enumerable&& other)
+		: source(std::move(other.source))
+		, key_selector(std::move(other.key_selector))
+		, hash(std::move(other.hash))
+		, resource(other.resource)
+	{
+	}
+
+	group_by_enumerable(Source&& source, KeySelector const& key_selector, Hash const& hash)
+		: source(std::move(source))
+		, key_selector(key_selector)
+		, hash(hash)
+		, resource(new_delete_resource())
+	{
+	}
+
+	enumerator_type get_enumerator()
+	{
+		return enumerator_type(build_lookup<key_type, element_type>(source, key_selector, hash, resource));
+	}
+
+	//builds the lookup in memory from resource
+	void set_memory_resource(memory_resource& resource)
+	{
+		this->resource = &resource;
+	}
+
+	//there are no more groups than values
+	size_hint get_size_hint()
+	{
+		size_hint hint = linq::get_size_hint(source);
+		return hint.is_exact() && hint.size() == 0 ? hint : hint.loosen();
+	}
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "enumerator.h"
+#include "lookup.h"
+
+namespace linq {
+
+// Enumerates the groups of a lookup, in order of first appearance of their keys
+template <typename Key, typename Value, typename Hash>
+class group_by_enumerator
+{
+public:
+	typedef grouping<Key, Value> value_type;
+	typedef lookup<Key, Value, Hash> lookup_type;
+
+private:
+	lookup_type groups;
+	std::size_t position;
+
+	group_by_enumerator(group_by_enumerator const&); // not defined
+	group_by_enumerator& operator=(group_by_enumerator const&); // not defined
+
+public:
+	group_by_enumerator()
+		: position(0)
+	{
+	}
+
+	group_by_enumerator(group_by_enumerator&& other)
+		: groups(std::move(other.groups))
+		, position(other.position)
+	{
+	}
+
+	group_by_enumerator& operator=(group_by_enumerator&& other)
+	{
+		groups = std::move(other.groups);
+		position = other.position;
+		return *this;
+	}
+
+	group_by_enumerator(lookup_type&& groups)
+		: groups(std::move(groups))
+		, position(0)
+	{
+	}
+
+	bool move_first()
+	{
+		position = 0;
+		return position < groups.size();
+	}
+
+	bool move_next()
+	{
+		return ++position < groups.size();
+	}
+
+	value_type current()
+	{
+		return groups.group(position);
+	}
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <type_traits>
+
+#include "enumerable.h"
+#include "size_hint.h"
+#include "memory_resource.h"
+#include "push_traits.h"
+#include "lookup.h"
+#include "group_join_enumerator.h"
+
+namespace linq {
+
+// Correlates each value of Outer with the group of Inner values with an equal key, as a hash join
+// o Inner is always the build side (every group must be complete before it is handed out); Outer is streamed
+// o Results come in outer order, one per outer value, with the inner values of each group in inner order
+template <typename Outer, typename Inner, typename OuterKeySelector, typename InnerKeySelector, typename ResultSelector, typename Hash>
+class group_join_enumerable
+{
+public:
+	typedef typename selected_key<OuterKeySelector, typename std::decay<typename Outer::value_type>::type>::type key_type;
+	typedef typename std::decay<typename Inner::value_type>::type inner_type;
+	typedef group_join_enumerator<typename Outer::enumerator_type, key_type, inner_type, OuterKeySelector, ResultSelector, Hash> enumerator_type;
+	typedef typename enumerator_type::value_type value_type;
+
+private:
+	Outer outer;
+	Inner inner;
+	OuterKeySelector outer_key_selector;
+	InnerKeySelector inner_key_selector;
+	ResultSelector result_selector;
+	Hash hash;
+	memory_resource* resource;
+
+	group_join_enumerable(group_join_enumerable const&); // not defined
+	group_join_enumerable& operator=(group_join_enumerable const&); // not defined
+
+public:
+	group_join_enumerable(group_join_enumerable&& other)
+		: outer(std::move(other.outer))
+		, inner(std::move(other.inner))
+		, outer_key_selector(std::move(other.outer_key_selector))
+		, inner_key_selector(std::move(other.inner_key_selector))
+		, result_selector(std::move(other.result_selector))
+		, hash(std::move(other.hash))
+		, resource(other.resource)
+	{
+	}
+
+	group_join_enumerable(Outer&& outer, Inner&& inner, OuterKeySelector const& outer_key_selector, InnerKeySelector const& inner_key_selector,
+		ResultSelector const& result_selector, Hash const& hash)
+		: outer(std::move(outer))
+		, inner(std::move(inner))
+		, outer_key_selector(outer_key_selector)
+		, inner_key_selector(inner_key_selector)
+		, result_selector(result_selector)
+		, hash(hash)
+		, resource(new_delete_resource())
+	{
+	}
+
+	enumerator_type get_enumerator()
+	{
+		return enumerator_type(outer.get_enumerator(), build_lookup<key_type, inner_type>(inner, inner_key_selector, hash, resource), outer_key_selector, result_selector);
+	}
+
+	//builds the lookup of inner values in memory from resource
+	void set_memory_resource(memory_resource& resource)
+	{
+		this->resource = &resource;
+	}
+
+	size_hint get_size_hint()
+	{
+		return linq::get_size_hint(outer);
+	}
+
+	template <typename Sink>
+	bool push(Sink& sink)
+	{
+		auto built = build_lookup<key_type, inner_type>(inner, inner_key_selector, hash, resource);
+		auto group_join_sink = [&](typename Outer::value_type value) -> bool
+		{
+			return sink(result_selector(value, built[outer_key_selector(value)]));
+		};
+		return linq::push(outer, group_join_sink);
+	}
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "enumerator.h"
+#include "lookup.h"
+
+namespace linq {
+
+// Enumerates result_selector(outer, group) for each outer value, where group holds the inner values with the same key
+// (and is empty if there are none)
+template <typename OuterEnumerator, typename Key, typename Inner, typename OuterKeySelector, typename ResultSelector, typename Hash>
+class group_join_enumerator
+{
+public:
+	typedef typename std::decay<typename OuterEnumerator::value_type>::type outer_type;
+	typedef typename std::result_of<ResultSelector(outer_type const&, grouping<Key, Inner> const&)>::type value_type;
+	typedef lookup<Key, Inner, Hash> lookup_type;
+
+private:
+	OuterEnumerator outer;
+	lookup_type inner;
+	OuterKeySelector outer_key_selector;
+	ResultSelector result_selector;
+
+	group_join_enumerator(group_join_enumerator const&); // not defined
+	group_join_enumerator& operator=(group_join_enumerator const&); // not defined
+
+public:
+	group_join_enumerator(group_join_enumerator&& other)
+		: outer(std::move(other.outer))
+		, inner(std::move(other.inner))
+		, outer_key_selector(std::move(other.outer_key_selector))
+		, result_selector(std::move(other.result_selector))
+	{
+	}
+
+	group_join_enumerator(OuterEnumerator&& outer, lookup_type&& inner, OuterKeySelector const& outer_key_selector, ResultSelector const& result_selector)
+		: outer(std::move(outer))
+		, inner(std::move(inner))
+		, outer_key_selector(outer_key_selector)
+		, result_selector(result_selector)
+	{
+	}
+
+	bool move_first()
+	{
+		return outer.move_first();
+	}
+
+	bool move_next()
+	{
+		return outer.move_next();
+	}
+
+	value_type current()
+	{
+		typename OuterEnumerator::value_type value = outer.current();
+		return result_selector(value, inner[outer_key_selector(value)]);
+	}
+};
+
+}
\ No newline at end of file
@@ -4,10 +4,24 @@
 #include <vector>
 #include <type_traits>
 #include <memory>
+#include <stdexcept>
+#include <functional>
 
 #include "enumerable.h"
+#include "batch_traits.h"
+#include "size_hint.h"
+#include "prefix_hint.h"
+#include "sort_key.h"
+#include "random_access_traits.h"
+#include "push_traits.h"
+#include "thread_pool.h"
+#include "memory_resource.h"
+#include "parallel_interactive.h"
+#include "simd_reduce.h"
 #include "captured_enumerable.h"
+#include "erased_enumerable.h"
 #include "memoize_enumerable.h"
+#include "memoize_all_enumerable.h"
 #include "from_enumerable.h"
 #include "empty_enumerable.h"
 #include "return_enumerable.h"
@@ -20,9 +34,16 @@
 #include "take_while_enumerable.h"
 #include "skip_while_enumerable.h"
 #include "merge_enumerable.h"
+#include "merge_all_enumerable.h"
+#include "group_by_enumerable.h"
+#include "join_enumerable.h"
+#include "group_join_enumerable.h"
+#include "distinct_enumerable.h"
+#include "distinct_sorted_enumerable.h"
 #include "counter_predicate.h"
 #include "negated_predicate.h"
 #include "static_cast_selector.h"
+#include "descending_selector.h"
 
 namespace linq {
 
@@ -63,6 +84,11 @@ namespace linq {
 			return source.get_enumerator();
 		}
 
+		size_hint get_size_hint()
+		{
+			return linq::get_size_hint(source);
+		}
+
 		//Interact with the underlying Enumerable<T> as another interactive type
 		//Enables the analogue of .NET IEnumerable<T> extension methods
 		template <typename TInteractive>
@@ -73,7 +99,7 @@ namespace linq {
 
 		std::shared_ptr<enumerable<value_type>> ref_count()
 		{
-			return std::make_shared<enumerable_type>(std::move(source));
+			return std::make_shared<erased_enumerable<enumerable_type>>(std::move(source));
 		}
 
 		interactive<captured_enumerable<value_type>> capture()
@@ -81,11 +107,24 @@ namespace linq {
 			return captured_enumerable<value_type>(ref_count());
 		}
 
+		//Reduce in parallel on pool; chunks are never smaller than min_chunk_size source positions
+		parallel_interactive<enumerable_type> parallel(thread_pool& pool = thread_pool::default_pool(), std::size_t min_chunk_size = 16384)
+		{
+			return parallel_interactive<enumerable_type>(std::move(source), pool, min_chunk_size);
+		}
+
 		interactive<memoize_enumerable<enumerable_type>> memoize()
 		{
 			return memoize_enumerable<enumerable_type>(std::move(source));
 		}
 
+		//Enumerate source at most once, keeping its values in a chunked buffer that every enumerator reads, and pulls
+		//from source only past the values produced so far; see memoize_all_enumerable
+		interactive<memoize_all_enumerable<enumerable_type>> memoize_all()
+		{
+			return memoize_all_enumerable<enumerable_type>(std::move(source));
+		}
+
 		template <typename Selector>
 		interactive<select_enumerable<enumerable_type, Selector>> select(Selector const& selector)
 		{
@@ -114,6 +153,12 @@ namespace linq {
 			{
 				return selector(v1) < selector(v2);
 			}
+
+			typedef typename std::decay<decltype(std::declval<Selector&>()(std::declval<value_type_no_ref const&>()))>::type key_type;
+			key_type key(value_type_no_ref const& v)
+			{
+				return selector(v);
+			}
 		};
 
 		template <typename Selector>
@@ -122,6 +167,13 @@ namespace linq {
 			return order_by_enumerable<enumerable_type, CompareFromSelector<Selector>>(std::move(source), CompareFromSelector<Selector>(selector));
 		}
 
+		template <typename Selector>
+		interactive<order_by_enumerable<enumerable_type, CompareFromSelector<descending_selector<typename std::remove_reference<value_type>::type, Selector>>>>
+		order_by_descending(Selector const& selector)
+		{
+			return order_by(descending_selector<typename std::remove_reference<value_type>::type, Selector>(selector));
+		}
+
 		template <typename CompareFirst, typename CompareThen>
 		struct MultiCompare
 		{
@@ -145,6 +197,14 @@ namespace linq {
 				return c_then(v1,v2);
 			}
 
+			//keys of both levels as a pair, which orders lexicographically as above (void if either level has no keys)
+			typedef typename std::conditional<sort_key_traits<CompareFirst>::has_key && sort_key_traits<CompareThen>::has_key,
+				std::pair<typename sort_key_traits<CompareFirst>::key_type, typename sort_key_traits<CompareThen>::key_type>,
+				void>::type key_type;
+			key_type key(value_type_no_ref const& v)
+			{
+				return key_type(c_first.key(v), c_then.key(v));
+			}
 		};
 
 		template <typename Selector, typename enumerable_type2 = enumerable_type>
@@ -152,9 +212,60 @@ namespace linq {
 		then_by(Selector const& selector)
 		{
 			typedef MultiCompare<typename enumerable_type::compare_type, CompareFromSelector<Selector>> NewCompare;
-			return order_by_enumerable<typename enumerable_type::source_type, NewCompare>(std::move(source.source), NewCompare(source.compare, CompareFromSelector<Selector>(selector)));
+			return order_by_enumerable<typename enumerable_type::source_type, NewCompare>(std::move(source.source), NewCompare(source.compare, CompareFromSelector<Selector>(selector)), source.policy);
+
+
+		}
+
+		template <typename Selector, typename enumerable_type2 = enumerable_type>
+		interactive<order_by_enumerable<typename enumerable_type2::source_type, MultiCompare<typename enumerable_type2::compare_type, CompareFromSelector<descending_selector<typename std::remove_reference<value_type>::type, Selector>>>>>
+		then_by_descending(Selector const& selector)
+		{
+			return then_by(descending_selector<typename std::remove_reference<value_type>::type, Selector>(selector));
+		}
+
+		//Sort by memcmp-ordered encodings of the composite keys (see normalized_key.h) rather than level by level;
+		//call after order_by(..).then_by(..)
+		template <typename enumerable_type2 = enumerable_type>
+		interactive<order_by_enumerable<typename enumerable_type2::source_type, typename enumerable_type2::compare_type>>
+		normalized_keys()
+		{
+			static_assert(normalized_key_traits<typename sort_key_traits<typename enumerable_type2::compare_type>::key_type>::is_normalizable,
+				"normalized_keys() encodes the sort keys of order_by(..).then_by(..): they must be integers, floating point, std::string, or pairs and tuples of those (descending or not).");
+			source.policy.normalize_keys = true;
+			return std::move(source);
+		}
 
+		//Buffer at most bytes of values (sizeof each) in memory, spilling sorted runs beyond that to temporary files
+		//that are merged while enumerating; the values need a spill_serializer (see external_sort.h);
+		//call after order_by(..).then_by(..)
+		template <typename enumerable_type2 = enumerable_type>
+		interactive<order_by_enumerable<typename enumerable_type2::source_type, typename enumerable_type2::compare_type>>
+		memory_budget(std::size_t bytes)
+		{
+			static_assert(spill_serializer<typename std::remove_reference<value_type>::type>::is_serializable,
+				"memory_budget() spills values to files: specialize linq::spill_serializer for this value type.");
+			source.policy.memory_budget = bytes;
+			return std::move(source);
+		}
+
+		//Sort buffers of at least parallel_threshold values on pool; call after order_by(..).then_by(..)
+		template <typename enumerable_type2 = enumerable_type>
+		interactive<order_by_enumerable<typename enumerable_type2::source_type, typename enumerable_type2::compare_type>>
+		parallel_sort(thread_pool& pool = thread_pool::default_pool(), std::size_t parallel_threshold = sort_policy().parallel_threshold)
+		{
+			source.policy.pool = &pool;
+			source.policy.parallel_threshold = parallel_threshold;
+			return std::move(source);
+		}
 
+		//Allocate the buffers of the operator before (order_by(..).then_by(..), group_by, join, group_join or distinct) from
+		//resource rather than the global heap, e.g. from a monotonic_buffer_resource released when the query is done;
+		//resource must outlive the enumerators and groupings of the query
+		interactive<enumerable_type> buffer_in(memory_resource& resource)
+		{
+			source.set_memory_resource(resource);
+			return std::move(source);
 		}
 
 		template <class T>
@@ -218,6 +329,7 @@ namespace linq {
 
 		interactive<take_while_enumerable<enumerable_type, counter_predicate<value_type>>> take(std::size_t count)
 		{
+			linq::set_prefix_hint(source, count);
 			return take_while(counter_predicate<value_type>(count));
 		}
 
@@ -235,29 +347,144 @@ namespace linq {
 
 		interactive<skip_while_enumerable<enumerable_type, counter_predicate<value_type>>> skip(std::size_t count)
 		{
-			return skip_while(counter_predicate<value_type>(count));
+			std::size_t dropped = linq::drop_prefix(source, count);
+			return skip_while(counter_predicate<value_type>(count - dropped));
+		}
+
+		//Groups by key in a flat hash table; see group_by_enumerable
+		template <typename KeySelector>
+		interactive<group_by_enumerable<enumerable_type, KeySelector, std::hash<typename selected_key<KeySelector, typename std::decay<value_type>::type>::type>>>
+		group_by(KeySelector const& key_selector)
+		{
+			return group_by(key_selector, std::hash<typename selected_key<KeySelector, typename std::decay<value_type>::type>::type>());
+		}
+
+		template <typename KeySelector, typename Hash>
+		interactive<group_by_enumerable<enumerable_type, KeySelector, Hash>> group_by(KeySelector const& key_selector, Hash const& hash)
+		{
+			return group_by_enumerable<enumerable_type, KeySelector, Hash>(std::move(source), key_selector, hash);
+		}
+
+		//Inner join on equal keys as a hash join; see join_enumerable for the choice of build side and the order of results
+		template <typename Inner, typename OuterKeySelector, typename InnerKeySelector, typename ResultSelector>
+		interactive<join_enumerable<enumerable_type, typename std::decay<Inner>::type, OuterKeySelector, InnerKeySelector, ResultSelector, std::hash<typename selected_key<OuterKeySelector, typename std::decay<value_type>::type>::type>>>
+		join(Inner&& inner, OuterKeySelector const& outer_key_selector, InnerKeySelector const& inner_key_selector, ResultSelector const& result_selector)
+		{
+			return join(std::move(inner), outer_key_selector, inner_key_selector, result_selector, std::hash<typename selected_key<OuterKeySelector, typename std::decay<value_type>::type>::type>());
+		}
+
+		template <typename Inner, typename OuterKeySelector, typename InnerKeySelector, typename ResultSelector, typename Hash>
+		interactive<join_enumerable<enumerable_type, typename std::decay<Inner>::type, OuterKeySelector, InnerKeySelector, ResultSelector, Hash>>
+		join(Inner&& inner, OuterKeySelector const& outer_key_selector, InnerKeySelector const& inner_key_selector, ResultSelector const& result_selector, Hash const& hash)
+		{
+			return join_enumerable<enumerable_type, typename std::decay<Inner>::type, OuterKeySelector, InnerKeySelector, ResultSelector, Hash>(
+				std::move(source), std::move(inner), outer_key_selector, inner_key_selector, result_selector, hash);
+		}
+
+		//Hash the outer values instead when their size hint is smaller than the inner one, giving up outer order for
+		//inner order (see join_enumerable); call after join(..)
+		interactive<enumerable_type> build_smaller_side()
+		{
+			source.set_build_smaller_side();
+			return std::move(source);
+		}
+
+		//Correlates each value with the grouping of inner values with an equal key; see group_join_enumerable
+		template <typename Inner, typename OuterKeySelector, typename InnerKeySelector, typename ResultSelector>
+		interactive<group_join_enumerable<enumerable_type, typename std::decay<Inner>::type, OuterKeySelector, InnerKeySelector, ResultSelector, std::hash<typename selected_key<OuterKeySelector, typename std::decay<value_type>::type>::type>>>
+		group_join(Inner&& inner, OuterKeySelector const& outer_key_selector, InnerKeySelector const& inner_key_selector, ResultSelector const& result_selector)
+		{
+			return group_join(std::move(inner), outer_key_selector, inner_key_selector, result_selector, std::hash<typename selected_key<OuterKeySelector, typename std::decay<value_type>::type>::type>());
+		}
+
+		template <typename Inner, typename OuterKeySelector, typename InnerKeySelector, typename ResultSelector, typename Hash>
+		interactive<group_join_enumerable<enumerable_type, typename std::decay<Inner>::type, OuterKeySelector, InnerKeySelector, ResultSelector, Hash>>
+		group_join(Inner&& inner, OuterKeySelector const& outer_key_selector, InnerKeySelector const& inner_key_selector, ResultSelector const& result_selector, Hash const& hash)
+		{
+			return group_join_enumerable<enumerable_type, typename std::decay<Inner>::type, OuterKeySelector, InnerKeySelector, ResultSelector, Hash>(
+				std::move(source), std::move(inner), outer_key_selector, inner_key_selector, result_selector, hash);
+		}
+
+		//Lazily skips values seen before, keeping the distinct values in a flat hash index
+		interactive<distinct_enumerable<enumerable_type, identity_key, std::hash<typename std::decay<value_type>::type>>> distinct()
+		{
+			return distinct_by(identity_key());
+		}
+
+		template <typename Hash>
+		interactive<distinct_enumerable<enumerable_type, identity_key, Hash>> distinct(Hash const& hash)
+		{
+			return distinct_by(identity_key(), hash);
+		}
+
+		//Lazily skips values whose key was seen before, keeping the distinct keys in a flat hash index
+		template <typename KeySelector>
+		interactive<distinct_enumerable<enumerable_type, KeySelector, std::hash<typename selected_key<KeySelector, typename std::decay<value_type>::type>::type>>>
+		distinct_by(KeySelector const& key_selector)
+		{
+			return distinct_by(key_selector, std::hash<typename selected_key<KeySelector, typename std::decay<value_type>::type>::type>());
+		}
+
+		template <typename KeySelector, typename Hash>
+		interactive<distinct_enumerable<enumerable_type, KeySelector, Hash>> distinct_by(KeySelector const& key_selector, Hash const& hash)
+		{
+			return distinct_enumerable<enumerable_type, KeySelector, Hash>(std::move(source), key_selector, hash);
+		}
+
+		//Skips values equal to the one before them: distinct for sorted sources (or any with equal values adjacent), in constant memory
+		interactive<distinct_sorted_enumerable<enumerable_type>> distinct_sorted()
+		{
+			return distinct_sorted_enumerable<enumerable_type>(std::move(source));
 		}
 
 		template <typename T, typename BinaryOperation>
 		T aggregate(T seed, BinaryOperation const& func)
 		{
+			//a fused push loop beats batching here, so batches are only used for sources that cannot push
+			return aggregate(seed, func, std::integral_constant<bool,
+				!push_traits<enumerable_type>::is_pushed &&
+				batch_traits<enumerator_type>::is_batched &&
+				is_batch_callable<BinaryOperation const, T&, typename batch_traits<enumerator_type>::batch_type const&>::value>());
+		}
+
+	private:
+		template <typename T, typename BinaryOperation>
+		T aggregate(T seed, BinaryOperation const& func, std::true_type)
+		{
+			typedef typename batch_traits<enumerator_type>::batch_type batch_type;
+			static const std::size_t capacity = batch_capacity<batch_type>::value;
+			batch_type buffer[capacity];
+
 			T value = seed;
 			auto e = source.get_enumerator();
-			if (!e.move_first())
-				{
-					return value;
-				}
 			while (true)
 				{
-					value = func(value, e.current());
-					if (!e.move_next())
+					std::size_t count = e.next_batch(buffer, capacity);
+					for (std::size_t i = 0; i < count; ++i)
+						{
+							value = func(value, static_cast<batch_type const&>(buffer[i]));
+						}
+					if (count < capacity)
 						{
-							break;
+							return value;
 						}
 				}
+		}
+
+		template <typename T, typename BinaryOperation>
+		T aggregate(T seed, BinaryOperation const& func, std::false_type)
+		{
+			T value = seed;
+			auto sink = [&](value_type current) -> bool
+			{
+				value = func(value, std::forward<value_type>(current));
+				return true;
+			};
+			linq::push(source, sink);
 			return value;
 		}
 
+	public:
 		template <typename BinaryOperation>
 		value_type aggregate(BinaryOperation const& func)
 		{
@@ -271,21 +498,58 @@ namespace linq {
 			return value;
 		}
 
-		value_type sum()
+		//Arithmetic values are summed with the kernels of simd_kernels.h (pairwise for floating point values)
+		typename std::decay<value_type>::type sum()
+		{
+			return sum(std::integral_constant<bool, simd::kernels<typename std::decay<value_type>::type>::has_sum>());
+		}
+
+	private:
+		typename std::decay<value_type>::type sum(std::true_type)
 		{
-			return aggregate(static_cast<value_type>(0), std::plus<value_type>());
+			return simd_sum(source, typename simd_reduce_traits<enumerator_type>::sum_path());
 		}
 
-		value_type product()
+		typename std::decay<value_type>::type sum(std::false_type)
 		{
-			return aggregate(static_cast<value_type>(1), std::multiplies<value_type>());
+			typedef typename std::decay<value_type>::type result_type;
+			return aggregate(static_cast<result_type>(0), std::plus<result_type>());
+		}
+
+	public:
+
+		typename std::decay<value_type>::type product()
+		{
+			typedef typename std::decay<value_type>::type result_type;
+			return aggregate(static_cast<result_type>(1), std::multiplies<result_type>());
 		}
 
 		value_type min()
+		{
+			return min(typename simd_reduce_traits<enumerator_type>::minmax_path());
+		}
+
+	private:
+		value_type min(simd_contiguous_path)
+		{
+			auto e = source.get_enumerator();
+			if (e.size() == 0)
+				move_first_or_throw(e);
+			return e.at(simd_minmax_positions(e).first);
+		}
+
+		value_type min(simd_batched_path)
+		{
+			return simd_minmax_values(source).first;
+		}
+
+		value_type min(simd_scalar_path)
 		{
 			return aggregate(std::min<value_type>);
 		}
 
+	public:
+
 		template <typename Selector>
 		typename interactive<select_enumerable<enumerable_type, Selector>>::value_type min(Selector const& selector)
 		{
@@ -315,10 +579,31 @@ namespace linq {
 		}
 
 		value_type max()
+		{
+			return max(typename simd_reduce_traits<enumerator_type>::minmax_path());
+		}
+
+	private:
+		value_type max(simd_contiguous_path)
+		{
+			auto e = source.get_enumerator();
+			if (e.size() == 0)
+				move_first_or_throw(e);
+			return e.at(simd_minmax_positions(e).second);
+		}
+
+		value_type max(simd_batched_path)
+		{
+			return simd_minmax_values(source).second;
+		}
+
+		value_type max(simd_scalar_path)
 		{
 			return aggregate(std::max<value_type>);
 		}
 
+	public:
+
 		template <typename Selector>
 		typename interactive<select_enumerable<enumerable_type, Selector>>::value_type max(Selector const& selector)
 		{
@@ -336,6 +621,26 @@ namespace linq {
 		}
 
 		std::pair<value_type, value_type> minmax()
+		{
+			return minmax(typename simd_reduce_traits<enumerator_type>::minmax_path());
+		}
+
+	private:
+		std::pair<value_type, value_type> minmax(simd_contiguous_path)
+		{
+			auto e = source.get_enumerator();
+			if (e.size() == 0)
+				move_first_or_throw(e);
+			std::pair<std::size_t, std::size_t> positions = simd_minmax_positions(e);
+			return std::pair<value_type, value_type>(e.at(positions.first), e.at(positions.second));
+		}
+
+		std::pair<value_type, value_type> minmax(simd_batched_path)
+		{
+			return simd_minmax_values(source);
+		}
+
+		std::pair<value_type, value_type> minmax(simd_scalar_path)
 		{
 			auto e = source.get_enumerator();
 			move_first_or_throw(e);
@@ -356,6 +661,7 @@ namespace linq {
 			return std::make_pair(min_value, max_value);
 		}
 
+	public:
 		template <typename Selector>
 		std::pair<
 		typename interactive<select_enumerable<enumerable_type, Selector>>::value_type,
@@ -451,47 +757,223 @@ namespace linq {
 				return default_value;
 		}
 
-		std::size_t count()
+		value_type element_at(std::size_t index)
+		{
+			auto e = source.get_enumerator();
+			return element_at(e, index, std::integral_constant<bool, random_access_traits<enumerator_type>::is_random_access>());
+		}
+
+		value_type last()
 		{
 			auto e = source.get_enumerator();
+			return last(e, std::integral_constant<bool, random_access_traits<enumerator_type>::is_random_access>());
+		}
+
+	private:
+		static value_type element_at(enumerator_type& e, std::size_t index, std::true_type)
+		{
+			if (index >= e.size())
+				throw new std::out_of_range("element_at index is out of range");
+			return e.at(index);
+		}
+
+		static value_type element_at(enumerator_type& e, std::size_t index, std::false_type)
+		{
 			if (!e.move_first())
-				return 0;
-			std::size_t n = 1;
-			while (e.move_next())
+				throw new std::out_of_range("element_at index is out of range");
+			for (std::size_t i = 0; i < index; ++i)
+			{
+				if (!e.move_next())
+					throw new std::out_of_range("element_at index is out of range");
+			}
+			return e.current();
+		}
+
+		static value_type last(enumerator_type& e, std::true_type)
+		{
+			std::size_t size = e.size();
+			if (size == 0)
+				throw new std::logic_error("last called on an empty sequence");
+			return e.at(size - 1);
+		}
+
+		//holds the most recent value; references are held by address, since they cannot be reseated
+		template <typename T>
+		struct last_value
+		{
+			T value;
+			void set(T&& v) { value = std::move(v); }
+			T get() { return std::move(value); }
+		};
+
+		template <typename T>
+		struct last_value<T&>
+		{
+			T* value;
+			void set(T& v) { value = &v; }
+			T& get() { return *value; }
+		};
+
+		static value_type last(enumerator_type& e, std::false_type)
+		{
+			if (!e.move_first())
+				throw new std::logic_error("last called on an empty sequence");
+			last_value<value_type> value;
+			while (true)
+			{
+				value.set(e.current());
+				if (!e.move_next())
+					return value.get();
+			}
+		}
+
+	public:
+		std::size_t count()
+		{
+			size_hint hint = get_size_hint();
+			if (hint.is_exact())
+				return hint.size();
+			return count(std::integral_constant<bool, batch_traits<enumerator_type>::is_batched>());
+		}
+
+	private:
+		std::size_t count(std::true_type)
+		{
+			typedef typename batch_traits<enumerator_type>::batch_type batch_type;
+			static const std::size_t capacity = batch_capacity<batch_type>::value;
+			batch_type buffer[capacity];
+
+			auto e = source.get_enumerator();
+			std::size_t n = 0;
+			while (true)
+				{
+					std::size_t count = e.next_batch(buffer, capacity);
+					n += count;
+					if (count < capacity)
+						return n;
+				}
+		}
+
+		std::size_t count(std::false_type)
+		{
+			std::size_t n = 0;
+			auto sink = [&](value_type) -> bool
+			{
 				++n;
+				return true;
+			};
+			linq::push(source, sink);
 			return n;
 		}
 
+	public:
+
 		template <typename Predicate>
 		std::size_t count_if(Predicate const& predicate)
+		{
+			return count_if(predicate, std::integral_constant<bool,
+				contiguous_traits<enumerator_type>::is_contiguous &&
+				is_batch_callable<Predicate const, typename std::decay<value_type>::type const&>::value>());
+		}
+
+	private:
+		//counts without a branch per value, straight from contiguous storage, in a loop the compiler can vectorize
+		template <typename Predicate>
+		std::size_t count_if(Predicate const& predicate, std::true_type)
+		{
+			auto e = source.get_enumerator();
+			std::size_t size = e.size();
+			if (size == 0)
+				return 0;
+			typename std::decay<value_type>::type const* data = &e.at(0);
+			std::size_t n = 0;
+			for (std::size_t i = 0; i < size; ++i)
+				n += predicate(data[i]) ? 1 : 0;
+			return n;
+		}
+
+		template <typename Predicate>
+		std::size_t count_if(Predicate const& predicate, std::false_type)
 		{
 			return where(predicate).count();
 		}
 
+	public:
+
 		template <typename Action>
 		void for_each(Action const& action)
 		{
-			auto e = source.get_enumerator();
-			if (!e.move_first())
-				{
-					return;
-				}
-			while (true)
-				{
-					action(e.current());
-					if (!e.move_next())
-						return;
-				}
+			auto sink = [&](value_type value) -> bool
+			{
+				action(std::forward<value_type>(value));
+				return true;
+			};
+			linq::push(source, sink);
+		}
+
+		std::vector<typename std::decay<value_type>::type> to_vector()
+		{
+			std::vector<typename std::decay<value_type>::type> vector;
+			into_vector(vector);
+			return vector;
 		}
 
-		std::vector<value_type> to_vector()
+		//e.g. to_vector(resource_allocator<T>(&arena))
+		template <typename Allocator>
+		std::vector<typename std::decay<value_type>::type, Allocator> to_vector(Allocator const& allocator)
 		{
-			std::vector<value_type> vector;
+			std::vector<typename std::decay<value_type>::type, Allocator> vector(allocator);
 			into_vector(vector);
 			return vector;
 		}
 
-		void into_vector(std::vector<value_type>& vector)
+		template <typename KeySelector>
+		lookup<typename selected_key<KeySelector, typename std::decay<value_type>::type>::type, typename std::decay<value_type>::type> to_lookup(KeySelector key_selector)
+		{
+			return to_lookup(key_selector, std::hash<typename selected_key<KeySelector, typename std::decay<value_type>::type>::type>());
+		}
+
+		template <typename KeySelector, typename Hash>
+		lookup<typename selected_key<KeySelector, typename std::decay<value_type>::type>::type, typename std::decay<value_type>::type, Hash> to_lookup(KeySelector key_selector, Hash const& hash)
+		{
+			return build_lookup<typename selected_key<KeySelector, typename std::decay<value_type>::type>::type, typename std::decay<value_type>::type>(source, key_selector, hash);
+		}
+
+		template <typename KeySelector, typename Hash>
+		lookup<typename selected_key<KeySelector, typename std::decay<value_type>::type>::type, typename std::decay<value_type>::type, Hash> to_lookup(KeySelector key_selector, Hash const& hash, memory_resource& resource)
+		{
+			return build_lookup<typename selected_key<KeySelector, typename std::decay<value_type>::type>::type, typename std::decay<value_type>::type>(source, key_selector, hash, &resource);
+		}
+
+		template <typename Allocator>
+		void into_vector(std::vector<typename std::decay<value_type>::type, Allocator>& vector)
+		{
+			size_hint hint = get_size_hint();
+			if (hint.is_exact())
+				vector.reserve(vector.size() + hint.size());
+			into_vector(vector, std::integral_constant<bool, batch_traits<enumerator_type>::is_batched>());
+		}
+
+	private:
+		template <typename Allocator>
+		void into_vector(std::vector<typename std::decay<value_type>::type, Allocator>& vector, std::true_type)
+		{
+			typedef typename batch_traits<enumerator_type>::batch_type batch_type;
+			static const std::size_t capacity = batch_capacity<batch_type>::value;
+			batch_type buffer[capacity];
+
+			auto e = source.get_enumerator();
+			while (true)
+				{
+					std::size_t count = e.next_batch(buffer, capacity);
+					vector.insert(vector.end(), buffer, buffer + count);
+					if (count < capacity)
+						return;
+				}
+		}
+
+		template <typename Allocator>
+		void into_vector(std::vector<typename std::decay<value_type>::type, Allocator>& vector, std::false_type)
 		{
 			for_each([&](value_type const& value){ vector.emplace_back(value); });
 		}
@@ -539,4 +1021,25 @@ namespace linq {
 		return merge_enumerable<SourceA, SourceB>(std::move(sourceA), std::move(sourceB));
 	}
 
+	//Merges a range of enumerables (all of the same type) that are each sorted by their values
+	template <typename Range>
+	static interactive<merge_all_enumerable<Range, identity_key, less_key>> merge_all(Range&& range)
+	{
+		return merge_all_enumerable<Range, identity_key, less_key>(std::forward<Range>(range), identity_key(), less_key());
+	}
+
+	//Merges a range of enumerables (all of the same type) that are each sorted by the keys key_selector selects
+	template <typename Range, typename KeySelector>
+	static interactive<merge_all_enumerable<Range, KeySelector, less_key>> merge_all(Range&& range, KeySelector const& key_selector)
+	{
+		return merge_all_enumerable<Range, KeySelector, less_key>(std::forward<Range>(range), key_selector, less_key());
+	}
+
+	//Merges a range of enumerables (all of the same type) that are each sorted by compare on the keys key_selector selects
+	template <typename Range, typename KeySelector, typename Compare>
+	static interactive<merge_all_enumerable<Range, KeySelector, Compare>> merge_all(Range&& range, KeySelector const& key_selector, Compare const& compare)
+	{
+		return merge_all_enumerable<Range, KeySelector, Compare>(std::forward<Range>(range), key_selector, compare);
+	}
+
 }
\ No newline at end of file
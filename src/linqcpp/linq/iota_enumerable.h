@@ -1,13 +1,12 @@
 #pragma once
 
-#include "make_unique.h"
 #include "enumerable.h"
 #include "iota_enumerator.h"
 
 namespace linq {
 
 template <typename T>
-class iota_enumerable : public enumerable<T>
+class iota_enumerable
 {
 public:
 	typedef iota_enumerator<T> enumerator_type;
@@ -32,9 +31,14 @@ public:
 		return enumerator_type(start);
 	}
 
-	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
+	template <typename Sink>
+	bool push(Sink& sink)
 	{
-		return make_unique<enumerator_type>(std::move(get_enumerator()));
+		for (value_type value = start; ; ++value)
+		{
+			if (!sink(value))
+				return false;
+		}
 	}
 };
 
@@ -3,11 +3,12 @@
 #include <utility>
 
 #include "enumerator.h"
+#include "batch_traits.h"
 
 namespace linq {
 
 template <typename T>
-class iota_enumerator : public enumerator<T>
+class iota_enumerator
 {
 public:
 	typedef T value_type;
@@ -44,6 +45,22 @@ public:
 	{
 		return value;
 	}
+
+	std::size_t next_batch(value_type* buffer, std::size_t capacity)
+	{
+		for (std::size_t i = 0; i < capacity; ++i, ++value)
+		{
+			buffer[i] = value;
+		}
+		return capacity;
+	}
+};
+
+template <typename T>
+struct batch_traits<iota_enumerator<T>>
+{
+	typedef T batch_type;
+	static const bool is_batched = std::is_trivial<batch_type>::value;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <type_traits>
+
+#include "enumerable.h"
+#include "size_hint.h"
+#include "memory_resource.h"
+#include "push_traits.h"
+#include "lookup.h"
+#include "join_enumerator.h"
+
+namespace linq {
+
+// Inner join of Outer and Inner on equal keys, as a hash join
+// o One side (the build side) is grouped into a lookup with one key selection per value; the other is streamed
+// o Inner is the build side, so results come in outer order, and for each outer value in inner order
+// o After build_smaller_side(), Outer is the build side when both size hints are bounded and Outer's is smaller;
+//   then the roles are swapped and results come in inner order, and for each inner value in outer order
+template <typename Outer, typename Inner, typename OuterKeySelector, typename InnerKeySelector, typename ResultSelector, typename Hash>
+class join_enumerable
+{
+public:
+	typedef join_enumerator<typename Outer::enumerator_type, typename Inner::enumerator_type, OuterKeySelector, InnerKeySelector, ResultSelector, Hash> enumerator_type;
+	typedef typename enumerator_type::value_type value_type;
+	typedef typename enumerator_type::outer_type outer_type;
+	typedef typename enumerator_type::inner_type inner_type;
+	typedef typename enumerator_type::key_type key_type;
+
+private:
+	Outer outer;
+	Inner inner;
+	OuterKeySelector outer_key_selector;
+	InnerKeySelector inner_key_selector;
+	ResultSelector result_selector;
+	Hash hash;
+	memory_resource* resource;
+	bool smaller_side_built;
+
+	join_enumerable(join_enumerable const&); // not defined
+	join_enumerable& operator=(join_enumerable const&); // not defined
+
+	bool outer_is_build_side()
+	{
+		if (!smaller_side_built)
+			return false;
+		size_hint outer_hint = linq::get_size_hint(outer);
+		size_hint inner_hint = linq::get_size_hint(inner);
+		return outer_hint.is_bounded() && inner_hint.is_bounded() && outer_hint.size() < inner_hint.size();
+	}
+
+public:
+	join_enumerable(join_enumerable&& other)
+		: outer(std::move(other.outer))
+		, inner(std::move(other.inner))
+		, outer_key_selector(std::move(other.outer_key_selector))
+		, inner_key_selector(std::move(other.inner_key_selector))
+		, result_selector(std::move(other.result_selector))
+		, hash(std::move(other.hash))
+		, resource(other.resource)
+		, smaller_side_built(other.smaller_side_built)
+	{
+	}
+
+	join_enumerable(Outer&& outer, Inner&& inner, OuterKeySelector const& outer_key_selector, InnerKeySelector const& inner_key_selector,
+		ResultSelector const& result_selector, Hash const& hash)
+		: outer(std::move(outer))
+		, inner(std::move(inner))
+		, outer_key_selector(outer_key_selector)
+		, inner_key_selector(inner_key_selector)
+		, result_selector(result_selector)
+		, hash(hash)
+		, resource(new_delete_resource())
+		, smaller_side_built(false)
+	{
+	}
+
+	enumerator_type get_enumerator()
+	{
+		typedef typename enumerator_type::outer_probe_type outer_probe_type;
+		typedef typename enumerator_type::inner_probe_type inner_probe_type;
+		if (outer_is_build_side())
+		{
+			return enumerator_type(std::unique_ptr<outer_probe_type>(),
+				std::unique_ptr<inner_probe_type>(new inner_probe_type(inner.get_enumerator(), build_lookup<key_type, outer_type>(outer, outer_key_selector, hash, resource))),
+				outer_key_selector, inner_key_selector, result_selector);
+		}
+		return enumerator_type(std::unique_ptr<outer_probe_type>(new outer_probe_type(outer.get_enumerator(), build_lookup<key_type, inner_type>(inner, inner_key_selector, hash, resource))),
+			std::unique_ptr<inner_probe_type>(),
+			outer_key_selector, inner_key_selector, result_selector);
+	}
+
+	//builds the lookup of the build side in memory from resource
+	void set_memory_resource(memory_resource& resource)
+	{
+		this->resource = &resource;
+	}
+
+	//builds Outer instead of Inner when its size hint is smaller, giving up outer order
+	void set_build_smaller_side()
+	{
+		smaller_side_built = true;
+	}
+
+	//nothing is known about the number of matches, unless a side is empty
+	size_hint get_size_hint()
+	{
+		size_hint outer_hint = linq::get_size_hint(outer);
+		size_hint inner_hint = linq::get_size_hint(inner);
+		if ((outer_hint.is_bounded() && outer_hint.size() == 0) || (inner_hint.is_bounded() && inner_hint.size() == 0))
+			return size_hint::exact(0);
+		return size_hint::unknown();
+	}
+
+	template <typename Sink>
+	bool push(Sink& sink)
+	{
+		if (outer_is_build_side())
+		{
+			auto built = build_lookup<key_type, outer_type>(outer, outer_key_selector, hash, resource);
+			auto join_sink = [&](typename Inner::value_type value) -> bool
+			{
+				std::size_t group = built.find(inner_key_selector(value));
+				if (group == built.npos)
+					return true;
+				for (auto match = built.group_begin(group); match != built.group_end(group); ++match)
+				{
+					if (!sink(result_selector(*match, value)))
+						return false;
+				}
+				return true;
+			};
+			return linq::push(inner, join_sink);
+		}
+
+		auto built = build_lookup<key_type, inner_type>(inner, inner_key_selector, hash, resource);
+		auto join_sink = [&](typename Outer::value_type value) -> bool
+		{
+			std::size_t group = built.find(outer_key_selector(value));
+			if (group == built.npos)
+				return true;
+			for (auto match = built.group_begin(group); match != built.group_end(group); ++match)
+			{
+				if (!sink(result_selector(value, *match)))
+					return false;
+			}
+			return true;
+		};
+		return linq::push(outer, join_sink);
+	}
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "enumerator.h"
+#include "lookup.h"
+
+namespace linq {
+
+namespace join_detail {
+
+	//the current value of a probe enumerator: referenced if the enumerator yields references, copied otherwise
+	template <typename T>
+	struct probe_value
+	{
+		typename std::decay<T>::type value;
+
+		probe_value()
+			: value()
+		{
+		}
+
+		probe_value(probe_value&& other)
+			: value(std::move(other.value))
+		{
+		}
+
+		void set(T&& current)
+		{
+			value = std::forward<T>(current);
+		}
+
+		typename std::decay<T>::type const& get() const
+		{
+			return value;
+		}
+	};
+
+	template <typename T>
+	struct probe_value<T&>
+	{
+		T* value;
+
+		probe_value()
+			: value(nullptr)
+		{
+		}
+
+		void set(T& current)
+		{
+			value = &current;
+		}
+
+		T const& get() const
+		{
+			return *value;
+		}
+	};
+
+}
+
+// One side of a hash join: streams Enumerator and looks the key of each value up in a lookup of the other side,
+// stopping at each match in turn
+template <typename Enumerator, typename Key, typename Built, typename Hash>
+class hash_probe
+{
+public:
+	typedef lookup<Key, Built, Hash> lookup_type;
+
+private:
+	Enumerator stream;
+	lookup_type built;
+	join_detail::probe_value<typename Enumerator::value_type> value;
+	typename lookup_type::iterator match;
+	typename lookup_type::iterator last_match;
+
+	hash_probe(hash_probe const&); // not defined
+	hash_probe& operator=(hash_probe const&); // not defined
+
+	//moves to the first value from the current one on (if has_value) that has a match
+	template <typename KeySelector>
+	bool seek(bool has_value, KeySelector& key_selector)
+	{
+		for (; has_value; has_value = stream.move_next())
+		{
+			value.set(stream.current());
+			std::size_t group = built.find(key_selector(value.get()));
+			if (group != lookup_type::npos)
+			{
+				match = built.group_begin(group);
+				last_match = built.group_end(group);
+				return true;
+			}
+		}
+		return false;
+	}
+
+public:
+	hash_probe(hash_probe&& other)
+		: stream(std::move(other.stream))
+		, built(std::move(other.built))
+		, value(std::move(other.value))
+		, match(other.match)
+		, last_match(other.last_match)
+	{
+	}
+
+	hash_probe(Enumerator&& stream, lookup_type&& built)
+		: stream(std::move(stream))
+		, built(std::move(built))
+	{
+	}
+
+	template <typename KeySelector>
+	bool move_first(KeySelector& key_selector)
+	{
+		return seek(stream.move_first(), key_selector);
+	}
+
+	template <typename KeySelector>
+	bool move_next(KeySelector& key_selector)
+	{
+		if (++match != last_match)
+			return true;
+		return seek(stream.move_next(), key_selector);
+	}
+
+	typename std::decay<typename Enumerator::value_type>::type const& streamed() const
+	{
+		return value.get();
+	}
+
+	Built const& matched() const
+	{
+		return *match;
+	}
+};
+
+// Enumerates result_selector(outer, inner) for each pair of values with equal keys, probing the side that was not
+// hashed into a lookup
+template <typename OuterEnumerator, typename InnerEnumerator, typename OuterKeySelector, typename InnerKeySelector, typename ResultSelector, typename Hash>
+class join_enumerator
+{
+public:
+	typedef typename std::decay<typename OuterEnumerator::value_type>::type outer_type;
+	typedef typename std::decay<typename InnerEnumerator::value_type>::type inner_type;
+	typedef typename selected_key<OuterKeySelector, outer_type>::type key_type;
+	typedef typename std::result_of<ResultSelector(outer_type const&, inner_type const&)>::type value_type;
+	//probes the outer side, with the inner side hashed
+	typedef hash_probe<OuterEnumerator, key_type, inner_type, Hash> outer_probe_type;
+	//probes the inner side, with the outer side hashed
+	typedef hash_probe<InnerEnumerator, key_type, outer_type, Hash> inner_probe_type;
+
+private:
+	//exactly one of the probes is set: the one of the side that is streamed
+	std::unique_ptr<outer_probe_type> outer_probe;
+	std::unique_ptr<inner_probe_type> inner_probe;
+	OuterKeySelector outer_key_selector;
+	InnerKeySelector inner_key_selector;
+	ResultSelector result_selector;
+
+	join_enumerator(join_enumerator const&); // not defined
+	join_enumerator& operator=(join_enumerator const&); // not defined
+
+public:
+	join_enumerator(join_enumerator&& other)
+		: outer_probe(std::move(other.outer_probe))
+		, inner_probe(std::move(other.inner_probe))
+		, outer_key_selector(std::move(other.outer_key_selector))
+		, inner_key_selector(std::move(other.inner_key_selector))
+		, result_selector(std::move(other.result_selector))
+	{
+	}
+
+	join_enumerator(std::unique_ptr<outer_probe_type>&& outer_probe, std::unique_ptr<inner_probe_type>&& inner_probe,
+		OuterKeySelector const& outer_key_selector, InnerKeySelector const& inner_key_selector, ResultSelector const& result_selector)
+		: outer_probe(std::move(outer_probe))
+		, inner_probe(std::move(inner_probe))
+		, outer_key_selector(outer_key_selector)
+		, inner_key_selector(inner_key_selector)
+		, result_selector(result_selector)
+	{
+	}
+
+	bool move_first()
+	{
+		return outer_probe ? outer_probe->move_first(outer_key_selector) : inner_probe->move_first(inner_key_selector);
+	}
+
+	bool move_next()
+	{
+		return outer_probe ? outer_probe->move_next(outer_key_selector) : inner_probe->move_next(inner_key_selector);
+	}
+
+	value_type current()
+	{
+		if (outer_probe)
+			return result_selector(outer_probe->streamed(), outer_probe->matched());
+		return result_selector(inner_probe->matched(), inner_probe->streamed());
+	}
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "memory_resource.h"
+#include "flat_hash.h"
+#include "size_hint.h"
+#include "push_traits.h"
+
+namespace linq {
+
+// The key type a KeySelector selects from values of type Value
+template <typename KeySelector, typename Value>
+struct selected_key
+{
+	typedef typename std::decay<decltype(std::declval<KeySelector&>()(std::declval<Value const&>()))>::type type;
+};
+
+// One group of a lookup: its key, and its values as a contiguous block in source order
+// o Shares the lookup's value storage, so it stays valid (and cheap to copy) after the lookup is gone
+// o Enumerable with linq::from
+template <typename Key, typename Value>
+class grouping
+{
+public:
+	typedef std::vector<Value, resource_allocator<Value>> storage_type;
+	typedef typename storage_type::const_iterator iterator;
+	typedef iterator const_iterator;
+
+private:
+	Key group_key;
+	std::shared_ptr<storage_type const> values;
+	std::size_t first;
+	std::size_t last;
+
+public:
+	grouping()
+		: group_key()
+		, first(0)
+		, last(0)
+	{
+	}
+
+	grouping(Key const& key, std::shared_ptr<storage_type const> const& values, std::size_t first, std::size_t last)
+		: group_key(key)
+		, values(values)
+		, first(first)
+		, last(last)
+	{
+	}
+
+	Key const& key() const
+	{
+		return group_key;
+	}
+
+	std::size_t size() const
+	{
+		return last - first;
+	}
+
+	bool empty() const
+	{
+		return first == last;
+	}
+
+	iterator begin() const
+	{
+		return values ? values->begin() + first : iterator();
+	}
+
+	iterator end() const
+	{
+		return values ? values->begin() + last : iterator();
+	}
+};
+
+// Values grouped by key, as built by interactive::to_lookup and group_by
+// o Keys are numbered by a flat_hash_index in order of first appearance
+// o The values of all groups are stored in one vector, each group a contiguous block in source order
+// o Everything (index, values, offsets) is allocated from the memory_resource the lookup was built with
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class lookup
+{
+public:
+	typedef Key key_type;
+	typedef grouping<Key, Value> grouping_type;
+	typedef typename grouping_type::storage_type storage_type;
+	typedef std::vector<std::size_t, resource_allocator<std::size_t>> offsets_type;
+	typedef typename storage_type::const_iterator iterator;
+
+	static const std::size_t npos = flat_hash_index<Key, Hash>::npos;
+
+private:
+	flat_hash_index<Key, Hash> index;
+	std::shared_ptr<storage_type const> values;
+	//group g is [offsets[g], offsets[g + 1]) of values
+	offsets_type offsets;
+
+	lookup(lookup const&); // not defined
+	lookup& operator=(lookup const&); // not defined
+
+public:
+	lookup()
+		: offsets(1, 0)
+	{
+	}
+
+	lookup(lookup&& other)
+		: index(std::move(other.index))
+		, values(std::move(other.values))
+		, offsets(std::move(other.offsets))
+	{
+	}
+
+	lookup& operator=(lookup&& other)
+	{
+		index = std::move(other.index);
+		values = std::move(other.values);
+		offsets = std::move(other.offsets);
+		return *this;
+	}
+
+	//ungrouped[i] belongs to group groups[i], an index into index; the values are moved into blocks by a stable
+	//counting sort on the group, or kept as they are if each group already is contiguous; the lookup allocates
+	//from the resource of ungrouped
+	lookup(flat_hash_index<Key, Hash>&& index, storage_type&& ungrouped, offsets_type const& groups)
+		: index(std::move(index))
+		, offsets(this->index.size() + 1, 0, groups.get_allocator())
+	{
+		resource_allocator<Value> allocator = ungrouped.get_allocator();
+		bool contiguous = true;
+		for (std::size_t i = 0; i < groups.size(); ++i)
+		{
+			++offsets[groups[i] + 1];
+			if (i != 0 && groups[i] != groups[i - 1] && groups[i] != groups[i - 1] + 1)
+				contiguous = false;
+		}
+		for (std::size_t g = 1; g < offsets.size(); ++g)
+			offsets[g] += offsets[g - 1];
+
+		if (contiguous)
+		{
+			values = std::allocate_shared<storage_type>(allocator, std::move(ungrouped));
+			return;
+		}
+
+		offsets_type order(groups.size(), 0, groups.get_allocator());
+		offsets_type next(offsets.begin(), offsets.end() - 1, groups.get_allocator());
+		for (std::size_t i = 0; i < groups.size(); ++i)
+			order[next[groups[i]]++] = i;
+
+		std::shared_ptr<storage_type> grouped = std::allocate_shared<storage_type>(allocator, allocator);
+		grouped->reserve(order.size());
+		for (auto i = order.begin(); i != order.end(); ++i)
+			grouped->push_back(std::move(ungrouped[*i]));
+		values = grouped;
+	}
+
+	//the number of groups
+	std::size_t size() const
+	{
+		return index.size();
+	}
+
+	//the g-th group, in order of first appearance
+	grouping_type group(std::size_t g) const
+	{
+		return grouping_type(index.key(g), values, offsets[g], offsets[g + 1]);
+	}
+
+	//the values of the g-th group, without the shared ownership of a grouping
+	iterator group_begin(std::size_t g) const
+	{
+		return values->begin() + offsets[g];
+	}
+
+	iterator group_end(std::size_t g) const
+	{
+		return values->begin() + offsets[g + 1];
+	}
+
+	//the index of the group of key, or npos
+	std::size_t find(Key const& key) const
+	{
+		return index.find(key);
+	}
+
+	bool contains(Key const& key) const
+	{
+		return index.find(key) != npos;
+	}
+
+	//the group of key, or an empty grouping if there is none
+	grouping_type operator[](Key const& key) const
+	{
+		std::size_t g = index.find(key);
+		if (g == npos)
+			return grouping_type(key, values, 0, 0);
+		return group(g);
+	}
+};
+
+template <typename Key, typename Value, typename Hash>
+const std::size_t lookup<Key, Value, Hash>::npos;
+
+// Groups the values of source by the keys key_selector selects, hashing them with hash, in memory from resource;
+// the value buffers are reserved up front if source has an exact size hint
+template <typename Key, typename Value, typename Hash, typename Enumerable, typename KeySelector>
+lookup<Key, Value, Hash> build_lookup(Enumerable& source, KeySelector& key_selector, Hash const& hash, memory_resource* resource = new_delete_resource())
+{
+	typedef typename Enumerable::value_type value_type;
+	typedef lookup<Key, Value, Hash> lookup_type;
+
+	flat_hash_index<Key, Hash> index(hash, std::equal_to<Key>(), resource);
+	typename lookup_type::storage_type values(resource);
+	typename lookup_type::offsets_type groups(resource);
+	size_hint hint = linq::get_size_hint(source);
+	if (hint.is_exact())
+	{
+		values.reserve(hint.size());
+		groups.reserve(hint.size());
+	}
+
+	auto sink = [&](value_type value) -> bool
+	{
+		groups.push_back(index.insert(key_selector(value)).first);
+		values.emplace_back(std::forward<value_type>(value));
+		return true;
+	};
+	linq::push(source, sink);
+	return lookup_type(std::move(index), std::move(values), groups);
+}
+
+}
\ No newline at end of file
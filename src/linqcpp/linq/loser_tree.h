@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace linq {
+
+// Tournament over player_count players (the sources of a k-way merge) that keeps the overall winner
+// o Each internal node remembers the loser of the match played there, so after the winner's value changes,
+//   replay(winner) plays one match per level: ceil(log2(player_count)) calls to beats
+// o beats(a, b) returns true if player a comes before player b; it must order the players strictly
+//   (break ties by player index) and rank exhausted players last
+class loser_tree
+{
+private:
+	//nodes[0] is the winner, nodes[1, player_count) the losers; leaves are player_count + player
+	std::vector<std::size_t> nodes;
+
+	template <typename Beats>
+	std::size_t play(std::size_t node, Beats& beats)
+	{
+		if (node >= nodes.size())
+			return node - nodes.size();
+		std::size_t left = play(2 * node, beats);
+		std::size_t right = play(2 * node + 1, beats);
+		if (beats(left, right))
+		{
+			nodes[node] = right;
+			return left;
+		}
+		nodes[node] = left;
+		return right;
+	}
+
+public:
+	template <typename Beats>
+	void build(std::size_t player_count, Beats& beats)
+	{
+		nodes.assign(player_count, 0);
+		if (player_count != 0)
+			nodes[0] = play(1, beats);
+	}
+
+	std::size_t winner() const
+	{
+		return nodes[0];
+	}
+
+	//replays the matches of player (the previous winner) from its leaf up to the root
+	template <typename Beats>
+	void replay(std::size_t player, Beats& beats)
+	{
+		for (std::size_t node = (player + nodes.size()) / 2; node > 0; node /= 2)
+		{
+			if (beats(nodes[node], player))
+				std::swap(nodes[node], player);
+		}
+		nodes[0] = player;
+	}
+};
+
+}
\ No newline at end of file
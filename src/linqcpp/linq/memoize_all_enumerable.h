@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "enumerable.h"
+#include "size_hint.h"
+#include "memoize_buffer.h"
+#include "memoize_all_enumerator.h"
+
+namespace linq {
+
+// Source, enumerated at most once: its values are kept in a memoize_buffer shared by every enumerator
+// o The first enumerator to reach a value pulls it from Source; later (or concurrent) enumerators read it from the buffer
+// o Enumerators share ownership of the buffer, so they (and references to values) stay valid after the enumerable is gone
+// o Prefix hints are not passed on to Source, since a later enumerator may read further than an earlier one
+template <typename Source>
+class memoize_all_enumerable
+{
+public:
+	typedef memoize_all_enumerator<Source> enumerator_type;
+	typedef typename enumerator_type::value_type value_type;
+
+private:
+	std::shared_ptr<memoize_buffer<Source>> buffer;
+
+	memoize_all_enumerable(memoize_all_enumerable const&); // not defined
+	memoize_all_enumerable& operator=(memoize_all_enumerable const&); // not defined
+
+public:
+	memoize_all_enumerable(memoize_all_enumerable&& other)
+		: buffer(std::move(other.buffer))
+	{
+	}
+
+	memoize_all_enumerable(Source&& source)
+		: buffer(std::make_shared<memoize_buffer<Source>>(std::move(source)))
+	{
+	}
+
+	enumerator_type get_enumerator()
+	{
+		return enumerator_type(buffer);
+	}
+
+	size_hint get_size_hint()
+	{
+		return buffer->get_size_hint();
+	}
+};
+
+}
\ No newline at end of file
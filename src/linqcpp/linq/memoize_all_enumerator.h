@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "enumerator.h"
+#include "memoize_buffer.h"
+
+namespace linq {
+
+// Reads the values of a memoize_buffer in order, asking it to pull from its source only past the values produced so far
+// o current() refers to the value in the buffer, which keeps its address as long as the buffer
+template <typename Source>
+class memoize_all_enumerator
+{
+public:
+	typedef memoize_buffer<Source> buffer_type;
+	typedef typename buffer_type::value_type const& value_type;
+
+private:
+	std::shared_ptr<buffer_type> buffer;
+	std::size_t index;
+	std::size_t chunk;
+	std::size_t offset;
+
+	memoize_all_enumerator(memoize_all_enumerator const&); // not defined
+	memoize_all_enumerator& operator=(memoize_all_enumerator const&); // not defined
+
+public:
+	memoize_all_enumerator(memoize_all_enumerator&& other)
+		: buffer(std::move(other.buffer))
+		, index(other.index)
+		, chunk(other.chunk)
+		, offset(other.offset)
+	{
+	}
+
+	memoize_all_enumerator(std::shared_ptr<buffer_type> const& buffer)
+		: buffer(buffer)
+		, index(0)
+		, chunk(0)
+		, offset(0)
+	{
+	}
+
+	bool move_first()
+	{
+		index = 0;
+		chunk = 0;
+		offset = 0;
+		return buffer->produce(index);
+	}
+
+	bool move_next()
+	{
+		++index;
+		if (++offset == buffer_type::chunk_size(chunk))
+		{
+			++chunk;
+			offset = 0;
+		}
+		return buffer->produce(index);
+	}
+
+	value_type current()
+	{
+		return buffer->at(chunk, offset);
+	}
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "size_hint.h"
+
+namespace linq {
+
+// The values of an enumerable, pulled from it once and kept for every enumerator of memoize_all
+// o Values are pulled only when an enumerator reaches one not produced yet, one at a time under a mutex;
+//   values already produced are read without locking, so enumerators may run concurrently on several threads
+// o Values are stored in chunks of first_chunk_size, 2 * first_chunk_size, 4 * first_chunk_size, ... values that
+//   are never moved, so a value keeps its address for as long as the buffer lives
+// o The source enumerator is destroyed as soon as it is exhausted
+template <typename Source>
+class memoize_buffer
+{
+public:
+	typedef typename std::decay<typename Source::value_type>::type value_type;
+
+	static const std::size_t first_chunk_size = 16;
+	//chunk c holds first_chunk_size << c values, so this many chunks hold as many values as memory can
+	static const std::size_t max_chunk_count = 8 * sizeof(std::size_t) - 4;
+
+private:
+	typedef typename std::aligned_storage<sizeof(value_type), std::alignment_of<value_type>::value>::type slot_type;
+	typedef typename Source::enumerator_type enumerator_type;
+
+	Source source;
+	size_hint source_hint;
+	std::unique_ptr<enumerator_type> enumerator;
+	std::unique_ptr<slot_type[]> chunks[max_chunk_count];
+	//where the next value goes
+	std::size_t last_chunk;
+	std::size_t last_offset;
+	std::atomic<std::size_t> produced;
+	std::atomic<bool> exhausted;
+	std::mutex mutex;
+
+	memoize_buffer(memoize_buffer const&); // not defined
+	memoize_buffer& operator=(memoize_buffer const&); // not defined
+
+	//appends the next value of source; false if there is none
+	bool pull()
+	{
+		bool has_value;
+		if (!enumerator)
+		{
+			enumerator.reset(new enumerator_type(source.get_enumerator()));
+			has_value = enumerator->move_first();
+		}
+		else
+			has_value = enumerator->move_next();
+
+		if (!has_value)
+		{
+			enumerator.reset();
+			exhausted.store(true, std::memory_order_release);
+			return false;
+		}
+
+		if (!chunks[last_chunk])
+			chunks[last_chunk].reset(new slot_type[chunk_size(last_chunk)]);
+		new (&chunks[last_chunk][last_offset]) value_type(enumerator->current());
+		if (++last_offset == chunk_size(last_chunk))
+		{
+			++last_chunk;
+			last_offset = 0;
+		}
+		produced.store(produced.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		return true;
+	}
+
+public:
+	explicit memoize_buffer(Source&& source)
+		: source(std::move(source))
+		, source_hint(linq::get_size_hint(this->source))
+		, last_chunk(0)
+		, last_offset(0)
+		, produced(0)
+		, exhausted(false)
+	{
+	}
+
+	~memoize_buffer()
+	{
+		std::size_t count = produced.load(std::memory_order_relaxed);
+		for (std::size_t chunk = 0; count != 0; ++chunk)
+		{
+			for (std::size_t offset = 0; offset < chunk_size(chunk) && count != 0; ++offset, --count)
+				at(chunk, offset).~value_type();
+		}
+	}
+
+	static std::size_t chunk_size(std::size_t chunk)
+	{
+		return first_chunk_size << chunk;
+	}
+
+	//makes sure the value at index is produced, pulling from source as far as needed; false if source ends before it
+	bool produce(std::size_t index)
+	{
+		if (index < produced.load(std::memory_order_acquire))
+			return true;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		while (index >= produced.load(std::memory_order_relaxed))
+		{
+			if (exhausted.load(std::memory_order_relaxed) || !pull())
+				return false;
+		}
+		return true;
+	}
+
+	//the value at offset in chunk, which must be produced
+	value_type& at(std::size_t chunk, std::size_t offset) const
+	{
+		return *reinterpret_cast<value_type*>(&chunks[chunk][offset]);
+	}
+
+	//exact once source is exhausted, else the hint of source
+	size_hint get_size_hint() const
+	{
+		if (exhausted.load(std::memory_order_acquire))
+			return size_hint::exact(produced.load(std::memory_order_acquire));
+		return source_hint;
+	}
+};
+
+template <typename Source>
+const std::size_t memoize_buffer<Source>::first_chunk_size;
+
+template <typename Source>
+const std::size_t memoize_buffer<Source>::max_chunk_count;
+
+}
\ No newline at end of file
@@ -1,14 +1,15 @@
 #pragma once
 
-#include "make_unique.h"
 #include "enumerable.h"
+#include "size_hint.h"
+#include "prefix_hint.h"
 #include "memoize_enumerator.h"
 #include "memoize_traits.h"
 
 namespace linq {
 
 template <typename Source>
-class memoize_enumerable : public enumerable<typename memoize_traits<Source>::value_type>
+class memoize_enumerable
 {
 public:
 	typedef memoize_enumerator<typename Source::enumerator_type> enumerator_type;
@@ -37,9 +38,14 @@ public:
 		return e;
 	}
 
-	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
+	size_hint get_size_hint()
 	{
-		return make_unique<enumerator_type>(std::move(get_enumerator()));
+		return linq::get_size_hint(source);
+	}
+
+	void set_prefix_hint(std::size_t count)
+	{
+		linq::set_prefix_hint(source, count);
 	}
 };
 
@@ -8,7 +8,7 @@
 namespace linq {
 
 template <typename Source>
-class memoize_enumerator : public enumerator<typename memoize_traits<Source>::value_type>
+class memoize_enumerator
 {
 public:
 	typedef typename memoize_traits<Source>::value_type value_type;
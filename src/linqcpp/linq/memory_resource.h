@@ -0,0 +1,233 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace linq {
+
+// Where buffering operators (order_by, group_by, join, group_join, distinct) and to_vector/to_lookup get their memory
+// o Modelled on std::pmr::memory_resource: allocate(bytes, alignment), deallocate(p, bytes, alignment)
+// o Alignments up to that of std::max_align_t are supported
+class memory_resource
+{
+public:
+	virtual ~memory_resource()
+	{
+	}
+
+	virtual void* allocate(std::size_t bytes, std::size_t alignment) = 0;
+	virtual void deallocate(void* p, std::size_t bytes, std::size_t alignment) = 0;
+
+	//memory allocated from one can be deallocated to the other
+	virtual bool is_equal(memory_resource const& other) const
+	{
+		return this == &other;
+	}
+};
+
+// The global heap, through operator new and operator delete; the default resource
+inline memory_resource* new_delete_resource()
+{
+	class new_delete_type : public memory_resource
+	{
+	public:
+		void* allocate(std::size_t bytes, std::size_t)
+		{
+			return ::operator new(bytes);
+		}
+
+		void deallocate(void* p, std::size_t, std::size_t)
+		{
+			::operator delete(p);
+		}
+
+		bool is_equal(memory_resource const& other) const
+		{
+			return dynamic_cast<new_delete_type const*>(&other) != nullptr;
+		}
+	};
+	static new_delete_type resource;
+	return &resource;
+}
+
+// An arena: hands out memory from chunks taken from upstream, and gives it all back at once with release (or destruction)
+// o deallocate does nothing, so a whole query (or request) is freed in one shot
+// o Starts in an optional initial buffer (e.g. on the stack); chunks then double in size
+// o Not thread safe: meant to be owned by one request, or one thread
+class monotonic_buffer_resource : public memory_resource
+{
+private:
+	struct chunk
+	{
+		chunk* previous;
+		std::size_t size;
+	};
+
+	static const std::size_t min_chunk_size = 1024;
+
+	memory_resource* upstream;
+	chunk* chunks;
+	char* initial_buffer;
+	std::size_t initial_size;
+	char* position;
+	std::size_t remaining;
+	std::size_t next_chunk_size;
+
+	monotonic_buffer_resource(monotonic_buffer_resource const&); // not defined
+	monotonic_buffer_resource& operator=(monotonic_buffer_resource const&); // not defined
+
+	static std::size_t first_chunk_size(std::size_t initial_size)
+	{
+		if (initial_size < min_chunk_size)
+			return min_chunk_size;
+		return initial_size;
+	}
+
+	static std::size_t padding(char const* p, std::size_t alignment)
+	{
+		return static_cast<std::size_t>(-reinterpret_cast<std::uintptr_t>(p)) & (alignment - 1);
+	}
+
+	void add_chunk(std::size_t bytes, std::size_t alignment)
+	{
+		std::size_t needed = sizeof(chunk) + alignment + bytes;
+		while (next_chunk_size < needed)
+			next_chunk_size *= 2;
+		chunk* added = static_cast<chunk*>(upstream->allocate(next_chunk_size, std::alignment_of<chunk>::value));
+		added->previous = chunks;
+		added->size = next_chunk_size;
+		chunks = added;
+		position = reinterpret_cast<char*>(added + 1);
+		remaining = next_chunk_size - sizeof(chunk);
+		next_chunk_size *= 2;
+	}
+
+public:
+	explicit monotonic_buffer_resource(memory_resource* upstream = new_delete_resource())
+		: upstream(upstream)
+		, chunks(nullptr)
+		, initial_buffer(nullptr)
+		, initial_size(0)
+		, position(nullptr)
+		, remaining(0)
+		, next_chunk_size(min_chunk_size)
+	{
+	}
+
+	//the first chunk is buffer, which must outlive the resource
+	monotonic_buffer_resource(void* buffer, std::size_t size, memory_resource* upstream = new_delete_resource())
+		: upstream(upstream)
+		, chunks(nullptr)
+		, initial_buffer(static_cast<char*>(buffer))
+		, initial_size(size)
+		, position(static_cast<char*>(buffer))
+		, remaining(size)
+		, next_chunk_size(first_chunk_size(size))
+	{
+	}
+
+	~monotonic_buffer_resource()
+	{
+		release();
+	}
+
+	void* allocate(std::size_t bytes, std::size_t alignment)
+	{
+		std::size_t pad = padding(position, alignment);
+		if (position == nullptr || pad + bytes > remaining)
+		{
+			add_chunk(bytes, alignment);
+			pad = padding(position, alignment);
+		}
+		char* allocated = position + pad;
+		position = allocated + bytes;
+		remaining -= pad + bytes;
+		return allocated;
+	}
+
+	void deallocate(void*, std::size_t, std::size_t)
+	{
+	}
+
+	//returns every chunk to upstream; everything allocated from the resource is invalidated
+	void release()
+	{
+		while (chunks)
+		{
+			chunk* previous = chunks->previous;
+			upstream->deallocate(chunks, chunks->size, std::alignment_of<chunk>::value);
+			chunks = previous;
+		}
+		position = initial_buffer;
+		remaining = initial_size;
+		next_chunk_size = first_chunk_size(initial_size);
+	}
+
+	memory_resource* upstream_resource() const
+	{
+		return upstream;
+	}
+};
+
+// A standard Allocator of T that allocates from a memory_resource (new_delete_resource by default)
+// o Like std::pmr::polymorphic_allocator, the container type does not depend on the resource
+// o Unlike it, the resource moves (and swaps) along with a container's memory, so moving a buffer never copies it
+template <typename T>
+class resource_allocator
+{
+public:
+	typedef T value_type;
+	typedef std::true_type propagate_on_container_move_assignment;
+	typedef std::true_type propagate_on_container_swap;
+
+private:
+	memory_resource* resource_ptr;
+
+public:
+	resource_allocator()
+		: resource_ptr(new_delete_resource())
+	{
+	}
+
+	resource_allocator(memory_resource* resource_ptr)
+		: resource_ptr(resource_ptr)
+	{
+	}
+
+	template <typename U>
+	resource_allocator(resource_allocator<U> const& other)
+		: resource_ptr(other.resource())
+	{
+	}
+
+	T* allocate(std::size_t count)
+	{
+		return static_cast<T*>(resource_ptr->allocate(count * sizeof(T), std::alignment_of<T>::value));
+	}
+
+	void deallocate(T* p, std::size_t count)
+	{
+		resource_ptr->deallocate(p, count * sizeof(T), std::alignment_of<T>::value);
+	}
+
+	memory_resource* resource() const
+	{
+		return resource_ptr;
+	}
+};
+
+template <typename T, typename U>
+bool operator==(resource_allocator<T> const& a, resource_allocator<U> const& b)
+{
+	return a.resource() == b.resource() || a.resource()->is_equal(*b.resource());
+}
+
+template <typename T, typename U>
+bool operator!=(resource_allocator<T> const& a, resource_allocator<U> const& b)
+{
+	return !(a == b);
+}
+
+}
\ No newline at end of file
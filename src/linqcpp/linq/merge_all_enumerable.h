@@ -0,0 +1,66 @@
+#pragma once
+
+#include "enumerable.h"
+#include "range_traits.h"
+#include "size_hint.h"
+#include "merge_all_enumerator.h"
+#include <iterator>
+
+namespace linq {
+
+// Merges a range of enumerables of the same type, each sorted by the keys KeySelector selects, with a loser tree
+// o Every head value (and its key) is cached, so each value costs one pass down a path of log k comparisons
+// o Ties go to the earlier enumerable in the range
+template <typename Range, typename KeySelector, typename Compare>
+class merge_all_enumerable
+{
+public:
+	typedef typename std::iterator_traits<typename range_traits<Range>::iterator_type>::value_type source_type;
+	typedef merge_all_enumerator<typename source_type::enumerator_type, KeySelector, Compare> enumerator_type;
+	typedef typename enumerator_type::value_type value_type;
+
+private:
+	Range range;
+	KeySelector selector;
+	Compare compare;
+
+	merge_all_enumerable(merge_all_enumerable const&); // not defined
+	merge_all_enumerable& operator=(merge_all_enumerable const&); // not defined
+
+public:
+	merge_all_enumerable(merge_all_enumerable&& other)
+		: range(std::forward<Range>(other.range))
+		, selector(std::move(other.selector))
+		, compare(std::move(other.compare))
+	{
+	}
+
+	merge_all_enumerable(Range&& range, KeySelector const& selector, Compare const& compare)
+		: range(std::forward<Range>(range))
+		, selector(selector)
+		, compare(compare)
+	{
+	}
+
+	enumerator_type get_enumerator()
+	{
+		using std::begin;
+		using std::end;
+		std::vector<typename source_type::enumerator_type> sources;
+		for (auto source = begin(range); source != end(range); ++source)
+			sources.push_back(source->get_enumerator());
+		return enumerator_type(std::move(sources), selector, compare);
+	}
+
+	size_hint get_size_hint()
+	{
+		using std::begin;
+		using std::end;
+		size_hint hint = size_hint::exact(0);
+		for (auto source = begin(range); source != end(range); ++source)
+			hint = hint.plus(linq::get_size_hint(*source));
+		return hint;
+	}
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "enumerator.h"
+#include "loser_tree.h"
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace linq {
+
+// The key selector and comparer merge_all uses unless it is given others
+struct identity_key
+{
+	template <typename T>
+	T const& operator()(T const& value) const
+	{
+		return value;
+	}
+};
+
+struct less_key
+{
+	template <typename T>
+	bool operator()(T const& a, T const& b) const
+	{
+		return a < b;
+	}
+};
+
+// The cached head of one merge_all source: its current value and the key selected from it
+template <typename Value, typename KeySelector>
+struct merge_head
+{
+	typedef typename std::decay<decltype(std::declval<KeySelector&>()(std::declval<Value const&>()))>::type key_type;
+
+	Value value;
+	key_type key;
+
+	merge_head(Value&& value, KeySelector& selector)
+		: value(std::move(value))
+		, key(selector(this->value))
+	{
+	}
+
+	key_type const& get_key() const
+	{
+		return key;
+	}
+};
+
+template <typename Value>
+struct merge_head<Value, identity_key>
+{
+	Value value;
+
+	merge_head(Value&& value, identity_key&)
+		: value(std::move(value))
+	{
+	}
+
+	Value const& get_key() const
+	{
+		return value;
+	}
+};
+
+// The head of one merge_all source while it has one, constructed in storage within the slot, so neither the
+// values nor their keys need be default constructible
+template <typename Head>
+class merge_slot
+{
+private:
+	typename std::aligned_storage<sizeof(Head), std::alignment_of<Head>::value>::type storage;
+	bool has_value;
+
+	merge_slot(merge_slot const&); // not defined
+	merge_slot& operator=(merge_slot const&); // not defined
+
+public:
+	merge_slot()
+		: has_value(false)
+	{
+	}
+
+	merge_slot(merge_slot&& other)
+		: has_value(false)
+	{
+		if (other.has_value)
+		{
+			new (&storage) Head(std::move(other.get()));
+			has_value = true;
+		}
+	}
+
+	~merge_slot()
+	{
+		reset();
+	}
+
+	template <typename Value, typename KeySelector>
+	void set(Value&& value, KeySelector& selector)
+	{
+		reset();
+		new (&storage) Head(std::forward<Value>(value), selector);
+		has_value = true;
+	}
+
+	void reset()
+	{
+		if (has_value)
+		{
+			get().~Head();
+			has_value = false;
+		}
+	}
+
+	bool is_set() const
+	{
+		return has_value;
+	}
+
+	Head& get()
+	{
+		return *reinterpret_cast<Head*>(&storage);
+	}
+};
+
+template <typename Enumerator, typename KeySelector, typename Compare>
+class merge_all_enumerator
+{
+public:
+	typedef typename std::decay<typename Enumerator::value_type>::type value_type;
+
+private:
+	typedef merge_head<value_type, KeySelector> head_type;
+
+	std::vector<Enumerator> sources;
+	//empty once its source is exhausted
+	std::vector<merge_slot<head_type>> heads;
+	loser_tree tree;
+	KeySelector selector;
+	Compare less;
+
+	merge_all_enumerator(merge_all_enumerator const&); // not defined
+	merge_all_enumerator& operator=(merge_all_enumerator const&); // not defined
+
+	//the head of source a comes first if its key is less, or equal and a is the earlier source
+	struct beats_type
+	{
+		merge_all_enumerator* merge;
+
+		bool operator()(std::size_t a, std::size_t b) const
+		{
+			merge_slot<head_type>& head_a = merge->heads[a];
+			merge_slot<head_type>& head_b = merge->heads[b];
+			if (!head_b.is_set())
+				return true;
+			if (!head_a.is_set())
+				return false;
+			if (a < b)
+				return !merge->less(head_b.get().get_key(), head_a.get().get_key());
+			return merge->less(head_a.get().get_key(), head_b.get().get_key());
+		}
+	};
+
+	void load(std::size_t source, bool has_value)
+	{
+		if (has_value)
+			heads[source].set(value_type(sources[source].current()), selector);
+		else
+			heads[source].reset();
+	}
+
+public:
+	merge_all_enumerator(merge_all_enumerator&& other)
+		: sources(std::move(other.sources))
+		, heads(std::move(other.heads))
+		, tree(std::move(other.tree))
+		, selector(std::move(other.selector))
+		, less(std::move(other.less))
+	{
+	}
+
+	merge_all_enumerator(std::vector<Enumerator>&& sources, KeySelector const& selector, Compare const& less)
+		: sources(std::move(sources))
+		, heads(this->sources.size())
+		, selector(selector)
+		, less(less)
+	{
+	}
+
+	bool move_first()
+	{
+		if (sources.empty())
+			return false;
+		for (std::size_t source = 0; source < sources.size(); ++source)
+			load(source, sources[source].move_first());
+		beats_type beats = { this };
+		tree.build(sources.size(), beats);
+		return heads[tree.winner()].is_set();
+	}
+
+	bool move_next()
+	{
+		std::size_t winner = tree.winner();
+		load(winner, sources[winner].move_next());
+		beats_type beats = { this };
+		tree.replay(winner, beats);
+		return heads[tree.winner()].is_set();
+	}
+
+	value_type current()
+	{
+		return heads[tree.winner()].get().value;
+	}
+};
+
+}
\ No newline at end of file
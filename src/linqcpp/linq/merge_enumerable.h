@@ -1,13 +1,13 @@
 #pragma once
 
-#include "make_unique.h"
 #include "enumerable.h"
+#include "size_hint.h"
 #include "merge_enumerator.h"
 
 namespace linq {
 
 template <typename SourceA, typename SourceB>
-class merge_enumerable : public enumerable<typename merge_enumerator<typename SourceA::enumerator_type, typename SourceB::enumerator_type>::value_type>
+class merge_enumerable
 {
 public:
 	typedef merge_enumerator<typename SourceA::enumerator_type, typename SourceB::enumerator_type> enumerator_type;
@@ -40,9 +40,9 @@ public:
 			std::move(sourceB.get_enumerator()));
 	}
 
-	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
+	size_hint get_size_hint()
 	{
-		return make_unique<enumerator_type>(std::move(get_enumerator()));
+		return linq::get_size_hint(sourceA).plus(linq::get_size_hint(sourceB));
 	}
 };
 
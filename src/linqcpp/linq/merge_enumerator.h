@@ -5,7 +5,7 @@
 namespace linq {
 
 template <typename SourceA, typename SourceB>
-class merge_enumerator : public enumerator<typename SourceA::value_type>
+class merge_enumerator
 {
 public:
 	typedef typename SourceA::value_type value_type;
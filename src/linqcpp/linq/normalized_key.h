@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "descending_selector.h"
+#include "radix_sort.h"
+
+namespace linq {
+
+// Normalized encoding of sort keys as byte strings that order with memcmp
+// o normalized_key_traits<Key>::is_normalizable for integers, IEEE float and double, std::string,
+//   and descending_key, std::pair and std::tuple of those
+// o static void encode(Key const& key, std::vector<unsigned char>& bytes)
+//   o Appends the encoding of key to bytes
+//   o Encodings compare with normalized_less (memcmp, then shorter first) exactly as their keys compare with <
+//   o No encoding is a proper prefix of another, so a composite key is encoded as the concatenation of its parts
+template <typename Key, typename Enable = void>
+struct normalized_key_traits
+{
+	static const bool is_normalizable = false;
+};
+
+namespace normalized_detail {
+
+	//appends the low size bytes of word, most significant first
+	inline void append_big_endian(std::uint64_t word, std::size_t size, std::vector<unsigned char>& bytes)
+	{
+		for (std::size_t i = size; i-- > 0; )
+			bytes.push_back(static_cast<unsigned char>(word >> (8 * i)));
+	}
+
+	template <typename Key>
+	struct unsigned_of
+	{
+		typedef typename std::make_unsigned<Key>::type type;
+	};
+
+	template <>
+	struct unsigned_of<bool>
+	{
+		typedef unsigned char type;
+	};
+
+}
+
+//big endian in the key's own width, with the sign bit flipped for signed keys
+template <typename Key>
+struct normalized_key_traits<Key, typename std::enable_if<std::is_integral<Key>::value>::type>
+{
+	static const bool is_normalizable = true;
+
+	static void encode(Key key, std::vector<unsigned char>& bytes)
+	{
+		typedef typename normalized_detail::unsigned_of<Key>::type unsigned_type;
+		unsigned_type bits = static_cast<unsigned_type>(key);
+		if (std::is_signed<Key>::value)
+			bits ^= static_cast<unsigned_type>(static_cast<unsigned_type>(1) << (sizeof(Key) * 8 - 1));
+		normalized_detail::append_big_endian(bits, sizeof(Key), bytes);
+	}
+};
+
+//the radix encoding (see radix_sort.h), big endian in the key's own width
+template <typename Key>
+struct normalized_key_traits<Key, typename std::enable_if<std::is_floating_point<Key>::value && radix_key_traits<Key>::is_radixable>::type>
+{
+	static const bool is_normalizable = true;
+
+	static void encode(Key key, std::vector<unsigned char>& bytes)
+	{
+		std::uint64_t word;
+		radix_key_traits<Key>::encode(key, &word);
+		normalized_detail::append_big_endian(word, sizeof(Key), bytes);
+	}
+};
+
+//0 bytes are escaped as 0 255 and the string is terminated by 0 0, so a string orders before its extensions
+template <>
+struct normalized_key_traits<std::string>
+{
+	static const bool is_normalizable = true;
+
+	static void encode(std::string const& key, std::vector<unsigned char>& bytes)
+	{
+		for (auto c = key.begin(); c != key.end(); ++c)
+		{
+			bytes.push_back(static_cast<unsigned char>(*c));
+			if (*c == 0)
+				bytes.push_back(255);
+		}
+		bytes.push_back(0);
+		bytes.push_back(0);
+	}
+};
+
+//complementing a prefix free encoding reverses its order
+template <typename Key>
+struct normalized_key_traits<descending_key<Key>, typename std::enable_if<normalized_key_traits<Key>::is_normalizable>::type>
+{
+	static const bool is_normalizable = true;
+
+	static void encode(descending_key<Key> const& key, std::vector<unsigned char>& bytes)
+	{
+		std::size_t first = bytes.size();
+		normalized_key_traits<Key>::encode(key.key, bytes);
+		for (std::size_t i = first; i < bytes.size(); ++i)
+			bytes[i] = static_cast<unsigned char>(~bytes[i]);
+	}
+};
+
+template <typename First, typename Second>
+struct normalized_key_traits<std::pair<First, Second>, typename std::enable_if<
+	normalized_key_traits<typename std::decay<First>::type>::is_normalizable
+	&& normalized_key_traits<typename std::decay<Second>::type>::is_normalizable>::type>
+{
+	static const bool is_normalizable = true;
+
+	static void encode(std::pair<First, Second> const& key, std::vector<unsigned char>& bytes)
+	{
+		normalized_key_traits<typename std::decay<First>::type>::encode(key.first, bytes);
+		normalized_key_traits<typename std::decay<Second>::type>::encode(key.second, bytes);
+	}
+};
+
+namespace normalized_detail {
+
+	template <typename Tuple, std::size_t Index = 0, std::size_t Size = std::tuple_size<Tuple>::value>
+	struct tuple_key
+	{
+		typedef normalized_key_traits<typename std::decay<typename std::tuple_element<Index, Tuple>::type>::type> element_traits;
+		typedef tuple_key<Tuple, Index + 1, Size> rest;
+
+		static const bool is_normalizable = element_traits::is_normalizable && rest::is_normalizable;
+
+		static void encode(Tuple const& key, std::vector<unsigned char>& bytes)
+		{
+			element_traits::encode(std::get<Index>(key), bytes);
+			rest::encode(key, bytes);
+		}
+	};
+
+	template <typename Tuple, std::size_t Size>
+	struct tuple_key<Tuple, Size, Size>
+	{
+		static const bool is_normalizable = true;
+
+		static void encode(Tuple const&, std::vector<unsigned char>&)
+		{
+		}
+	};
+
+}
+
+template <typename... Keys>
+struct normalized_key_traits<std::tuple<Keys...>, typename std::enable_if<normalized_detail::tuple_key<std::tuple<Keys...>>::is_normalizable>::type>
+	: normalized_detail::tuple_key<std::tuple<Keys...>>
+{
+};
+
+//the order of normalized encodings: memcmp over the common length, then the shorter first
+inline bool normalized_less(unsigned char const* a, std::size_t a_size, unsigned char const* b, std::size_t b_size)
+{
+	int order = std::memcmp(a, b, std::min(a_size, b_size));
+	return order < 0 || (order == 0 && a_size < b_size);
+}
+
+}
@@ -34,6 +34,19 @@ public:
 		return *this;
 	}
 
+	optional(optional const& other)
+		: _has_value(other._has_value)
+		, _value(other._value)
+	{
+	}
+
+	optional& operator=(optional const& other)
+	{
+		_has_value = other._has_value;
+		_value = other._value;
+		return *this;
+	}
+
 	optional(optional&& other)
 		: _has_value(other._has_value)
 		, _value(std::move(other._value))
@@ -1,13 +1,17 @@
 #pragma once
 
-#include "make_unique.h"
+#include <limits>
+
 #include "enumerable.h"
+#include "sort_policy.h"
+#include "size_hint.h"
+#include "prefix_hint.h"
 #include "order_by_enumerator.h"
 
 namespace linq {
 
 template <typename Source, typename Compare>
-class order_by_enumerable : public enumerable<typename std::remove_reference<typename Source::value_type>::type>
+class order_by_enumerable
 {
 public:
 	typedef order_by_enumerator<typename Source::enumerator_type, Compare> enumerator_type;
@@ -18,6 +22,7 @@ public:
 
 	Source source;
 	Compare compare;
+	sort_policy policy;
 private:
 	order_by_enumerable(order_by_enumerable const&); // not defined
 	order_by_enumerable& operator=(order_by_enumerable const&); // not defined
@@ -26,23 +31,50 @@ public:
 	order_by_enumerable(order_by_enumerable&& other)
 		: source(std::move(other.source))
 		, compare(std::move(other.compare))
+		, policy(other.policy)
 	{
 	}
 
-	order_by_enumerable(Source&& source, Compare const& compare)
+	order_by_enumerable(Source&& source, Compare const& compare, sort_policy const& policy = sort_policy())
 		: source(std::move(source))
 		, compare(compare)
+		, policy(policy)
 	{
 	}
 
 	enumerator_type get_enumerator()
 	{
-		return enumerator_type(source.get_enumerator(), compare);
+		return enumerator_type(source.get_enumerator(), compare, policy);
+	}
+
+	//buffers and sorts in memory from resource
+	void set_memory_resource(memory_resource& resource)
+	{
+		policy.resource = &resource;
+	}
+
+	void set_prefix_hint(std::size_t count)
+	{
+		if (count < policy.prefix)
+			policy.prefix = count;
+	}
+
+	//the values before the window are never produced, so all of them are left out
+	std::size_t drop_prefix(std::size_t count)
+	{
+		policy.skip = saturating_add(policy.skip, count);
+		if (policy.prefix != std::numeric_limits<std::size_t>::max())
+			policy.prefix = policy.prefix > count ? policy.prefix - count : 0;
+		return count;
 	}
 
-	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
+	//only policy.prefix values after the first policy.skip are ordered, and enumerated
+	size_hint get_size_hint()
 	{
-		return make_unique<enumerator_type>(std::move(get_enumerator()));
+		size_hint hint = linq::get_size_hint(source).skip(policy.skip);
+		if (policy.prefix == std::numeric_limits<std::size_t>::max())
+			return hint;
+		return hint.take(policy.prefix);
 	}
 };
 
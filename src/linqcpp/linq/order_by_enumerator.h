@@ -1,64 +1,454 @@
 #pragma once
 
 #include "enumerator.h"
+#include "memory_resource.h"
+#include "sort_policy.h"
+#include "parallel_sort.h"
+#include "adaptive_sort.h"
+#include "sort_key.h"
+#include "radix_sort.h"
+#include "normalized_key.h"
+#include "external_sort.h"
+#include "prefix_hint.h"
+#include <memory>
 #include <vector>
 #include <algorithm>
+#include <utility>
+#include <stdexcept>
 
 namespace linq {
 
 template <typename Source, typename Compare>
-class order_by_enumerator : public enumerator<typename std::remove_reference<typename Source::value_type>::type>
+class order_by_enumerator
 {
 public:
 	typedef typename std::remove_reference<typename Source::value_type>::type value_type;
 
 private:
-	std::vector<value_type> ordered_values;
-	typename std::vector<value_type>::iterator curr;
+	//the values, and the entries and heaps they are sorted by, are allocated from policy.resource
+	typedef std::vector<value_type, resource_allocator<value_type>> buffer_type;
+
+	buffer_type ordered_values;
+	typename buffer_type::iterator curr;
+	//stands in for spilled_merge when values cannot be spilled (and so never are), so that it is not instantiated
+	struct unspilled_merge
+	{
+		bool move_first()
+		{
+			return false;
+		}
+
+		bool move_next()
+		{
+			return false;
+		}
+
+		value_type const& current()
+		{
+			throw new std::logic_error("no sorted runs were spilled");
+		}
+	};
+
+	typedef typename std::conditional<spill_serializer<value_type>::is_serializable,
+		spilled_merge<value_type, Compare>,
+		unspilled_merge>::type merge_type;
+
+	//set if sorted runs were spilled, in which case the values are enumerated from it, after merge_skip values
+	std::unique_ptr<merge_type> merge;
+	std::size_t merge_skip;
 
 	order_by_enumerator(order_by_enumerator const&); // not defined
 	order_by_enumerator& operator=(order_by_enumerator const&); // not defined
 
-public:
-	order_by_enumerator(order_by_enumerator&& other)
-		: ordered_values(std::move(other.ordered_values))
-		,curr(std::move(other.curr))
+	//windows ending up to this far into the ordering are selected with a bounded heap, without buffering the whole source
+	static const std::size_t small_prefix = 1024;
+
+	//buffers of at least this size are radix sorted when their keys allow it
+	static const std::size_t radix_threshold = 256;
+	//keys up to this many radix words (see radix_sort.h)
+	static const std::size_t max_radix_words = 4;
+
+	typedef typename sort_key_traits<Compare>::key_type key_type;
+	typedef radix_key_traits<key_type> radix_traits;
+
+	//how values are compared: with Compare itself, by keys extracted once per value, or by radix sorting those keys
+	struct compare_values_tag {};
+	struct compare_keys_tag {};
+	struct radix_keys_tag : compare_keys_tag {};
+	typedef typename std::conditional<!sort_key_traits<Compare>::has_key,
+		compare_values_tag,
+		typename std::conditional<radix_traits::is_radixable && radix_traits::word_count <= max_radix_words,
+			radix_keys_tag,
+			compare_keys_tag>::type>::type sort_tag;
+
+	//a heap entry of select_smallest when Compare has keys
+	struct keyed_entry
+	{
+		key_type key;
+		std::size_t position;
+		value_type value;
+
+		keyed_entry(key_type&& key, std::size_t position, value_type&& value)
+			: key(std::move(key))
+			, position(position)
+			, value(std::move(value))
+		{
+		}
+	};
+
+	void buffer(Source& source, Compare& less, sort_policy const& policy)
 	{
+		buffer(source, less, policy, std::integral_constant<bool, spill_serializer<value_type>::is_serializable>());
 	}
 
-	order_by_enumerator(Source&& source, Compare const& compare)
+	void buffer(Source& source, Compare&, sort_policy const&, std::false_type)
 	{
 		if (!source.move_first())
+			return;
+		while (true)
+		{
+			ordered_values.push_back(source.current());
+			if (!source.move_next())
+				break;
+		}
+	}
+
+	//with a memory budget, every full buffer is sorted and spilled as a run, and the last one is kept in memory
+	void buffer(Source& source, Compare& less, sort_policy const& policy, std::true_type)
+	{
+		if (policy.memory_budget == std::numeric_limits<std::size_t>::max())
 		{
-			curr = ordered_values.end();
+			buffer(source, less, policy, std::false_type());
 			return;
 		}
+		if (!source.move_first())
+			return;
+
+		//a run only needs the values up to the end of the window; those before it are left out while merging
+		sort_policy run_policy = policy;
+		run_policy.skip = 0;
+		run_policy.prefix = saturating_add(policy.skip, policy.prefix);
+
+		std::size_t run_capacity = std::max<std::size_t>(1, policy.memory_budget / sizeof(value_type));
 		while (true)
 		{
 			ordered_values.push_back(source.current());
+			if (ordered_values.size() >= run_capacity)
+			{
+				if (!merge)
+					merge.reset(new merge_type(less));
+				sort(less, run_policy, sort_tag());
+				merge->spill(ordered_values.begin(), ordered_values.end());
+				ordered_values.clear();
+			}
 			if (!source.move_next())
 				break;
 		}
 
-		std::sort(ordered_values.begin(), ordered_values.end(), compare);
+		if (merge)
+		{
+			sort(less, run_policy, sort_tag());
+			merge->keep_last_run(std::move(ordered_values));
+			ordered_values.clear();
+			merge_skip = policy.skip;
+		}
+	}
+
+	//keeps the skip + prefix smallest values in a max-heap, and then all but the skip smallest of them; ties are broken
+	//by source position, so the result is stable
+	void select_smallest(Source& source, Compare& less, std::size_t skip, std::size_t prefix, compare_values_tag)
+	{
+		typedef std::pair<value_type, std::size_t> entry;
+		if (prefix == 0 || !source.move_first())
+			return;
+		std::size_t heap_size = skip + prefix;
+
+		auto entry_less = [&](entry const& a, entry const& b)
+		{
+			return less(a.first, b.first) || (!less(b.first, a.first) && a.second < b.second);
+		};
+
+		std::vector<entry, resource_allocator<entry>> heap(ordered_values.get_allocator());
+		std::size_t position = 0;
+		do
+		{
+			if (heap.size() < heap_size)
+			{
+				heap.push_back(entry(source.current(), position));
+				std::push_heap(heap.begin(), heap.end(), entry_less);
+			}
+			else
+			{
+				//a later value only displaces the largest if it is strictly less
+				value_type value = source.current();
+				if (less(value, heap.front().first))
+				{
+					std::pop_heap(heap.begin(), heap.end(), entry_less);
+					heap.back() = entry(std::move(value), position);
+					std::push_heap(heap.begin(), heap.end(), entry_less);
+				}
+			}
+			++position;
+		} while (source.move_next());
+
+		std::sort_heap(heap.begin(), heap.end(), entry_less);
+		skip = std::min(skip, heap.size());
+		ordered_values.reserve(heap.size() - skip);
+		for (auto it = heap.begin() + skip; it != heap.end(); ++it)
+			ordered_values.push_back(std::move(it->first));
+	}
+
+	//as above, with each value's key extracted once and kept next to it in the heap
+	void select_smallest(Source& source, Compare& less, std::size_t skip, std::size_t prefix, compare_keys_tag)
+	{
+		if (prefix == 0 || !source.move_first())
+			return;
+		std::size_t heap_size = skip + prefix;
+
+		auto entry_less = [](keyed_entry const& a, keyed_entry const& b)
+		{
+			return a.key < b.key || (!(b.key < a.key) && a.position < b.position);
+		};
+
+		std::vector<keyed_entry, resource_allocator<keyed_entry>> heap(ordered_values.get_allocator());
+		std::size_t position = 0;
+		do
+		{
+			value_type value = source.current();
+			key_type key = less.key(value);
+			if (heap.size() < heap_size)
+			{
+				heap.push_back(keyed_entry(std::move(key), position, std::move(value)));
+				std::push_heap(heap.begin(), heap.end(), entry_less);
+			}
+			else if (key < heap.front().key)
+			{
+				std::pop_heap(heap.begin(), heap.end(), entry_less);
+				heap.back() = keyed_entry(std::move(key), position, std::move(value));
+				std::push_heap(heap.begin(), heap.end(), entry_less);
+			}
+			++position;
+		} while (source.move_next());
+
+		std::sort_heap(heap.begin(), heap.end(), entry_less);
+		skip = std::min(skip, heap.size());
+		ordered_values.reserve(heap.size() - skip);
+		for (auto it = heap.begin() + skip; it != heap.end(); ++it)
+			ordered_values.push_back(std::move(it->value));
+	}
+
+	//a key encoded by normalized_key_traits, at [offset, offset + size) of a shared byte buffer
+	struct normalized_entry
+	{
+		std::size_t offset;
+		std::size_t size;
+		std::size_t position;
+	};
+
+	static std::size_t position_of(normalized_entry const& entry)
+	{
+		return entry.position;
+	}
+
+	static std::size_t position_of(std::size_t position)
+	{
+		return position;
+	}
+
+	static std::size_t position_of(std::pair<key_type, std::size_t> const& entry)
+	{
+		return entry.second;
+	}
+
+	//true if only a window of the size values will be enumerated
+	static bool is_windowed(sort_policy const& policy, std::size_t size)
+	{
+		return policy.skip != 0 || policy.prefix < size;
+	}
+
+	//sorts entries (positions in ordered_values, (key, position) pairs or normalized entries) by entry_less, then moves the values
+	//into that order; if only the window [skip, skip + prefix) will be enumerated, nth_element splits off the values
+	//before it and partial_sort orders just the window, in O(n log prefix)
+	template <typename Entry, typename EntryLess>
+	void order_entries(std::vector<Entry, resource_allocator<Entry>>& entries, EntryLess const& entry_less, sort_policy const& policy)
+	{
+		std::size_t first = std::min(policy.skip, entries.size());
+		std::size_t last = first + std::min(policy.prefix, entries.size() - first);
+		if (is_windowed(policy, entries.size()))
+		{
+			auto stable_less = [&](Entry const& a, Entry const& b)
+			{
+				return entry_less(a, b) || (!entry_less(b, a) && position_of(a) < position_of(b));
+			};
+			if (first != 0)
+				std::nth_element(entries.begin(), entries.begin() + first, entries.end(), stable_less);
+			std::partial_sort(entries.begin() + first, entries.begin() + last, entries.end(), stable_less);
+		}
+		else if (policy.pool && entries.size() >= policy.parallel_threshold)
+			parallel_stable_sort(entries.begin(), entries.end(), entry_less, *policy.pool);
+		else
+			adaptive_stable_sort(entries.begin(), entries.end(), entry_less);
+
+		buffer_type sorted(ordered_values.get_allocator());
+		sorted.reserve(last - first);
+		for (std::size_t i = first; i < last; ++i)
+			sorted.push_back(std::move(ordered_values[position_of(entries[i])]));
+		ordered_values.swap(sorted);
+	}
+
+	void sort(Compare& less, sort_policy const& policy, compare_values_tag)
+	{
+		if (is_windowed(policy, ordered_values.size()))
+		{
+			std::vector<std::size_t, resource_allocator<std::size_t>> positions(ordered_values.size(), 0, ordered_values.get_allocator());
+			for (std::size_t i = 0; i < positions.size(); ++i)
+				positions[i] = i;
+			order_entries(positions, [&](std::size_t a, std::size_t b)
+			{
+				return less(ordered_values[a], ordered_values[b]);
+			}, policy);
+		}
+		else if (policy.pool && ordered_values.size() >= policy.parallel_threshold)
+			parallel_stable_sort(ordered_values.begin(), ordered_values.end(), less, *policy.pool);
+		else
+			adaptive_stable_sort(ordered_values.begin(), ordered_values.end(), less);
+	}
+
+	void sort(Compare& less, sort_policy const& policy, compare_keys_tag)
+	{
+		sort_keys(less, policy, std::integral_constant<bool, normalized_key_traits<key_type>::is_normalizable>());
+	}
+
+	//one memcmp per comparison, however many levels the key has
+	void sort_keys(Compare& less, sort_policy const& policy, std::true_type)
+	{
+		if (!policy.normalize_keys)
+		{
+			sort_keys(less, policy, std::false_type());
+			return;
+		}
+
+		std::vector<unsigned char> bytes;
+		std::vector<normalized_entry, resource_allocator<normalized_entry>> entries(ordered_values.get_allocator());
+		entries.reserve(ordered_values.size());
+		for (std::size_t i = 0; i < ordered_values.size(); ++i)
+		{
+			normalized_entry entry;
+			entry.offset = bytes.size();
+			normalized_key_traits<key_type>::encode(less.key(ordered_values[i]), bytes);
+			entry.size = bytes.size() - entry.offset;
+			entry.position = i;
+			entries.push_back(entry);
+		}
+
+		unsigned char const* data = bytes.data();
+		order_entries(entries, [data](normalized_entry const& a, normalized_entry const& b)
+		{
+			return normalized_less(data + a.offset, a.size, data + b.offset, b.size);
+		}, policy);
+	}
+
+	//decorate-sort-undecorate: the selectors run once per value rather than twice per comparison
+	void sort_keys(Compare& less, sort_policy const& policy, std::false_type)
+	{
+		typedef std::pair<key_type, std::size_t> entry;
+		std::vector<entry, resource_allocator<entry>> entries(ordered_values.get_allocator());
+		entries.reserve(ordered_values.size());
+		for (std::size_t i = 0; i < ordered_values.size(); ++i)
+			entries.push_back(entry(less.key(ordered_values[i]), i));
+
+		order_entries(entries, [](entry const& a, entry const& b)
+		{
+			return a.first < b.first;
+		}, policy);
+	}
+
+	//full sequential sorts of radixable keys use radix_order, the rest compare the extracted keys
+	void sort(Compare& less, sort_policy const& policy, radix_keys_tag)
+	{
+		std::size_t size = ordered_values.size();
+		if (size >= radix_threshold && !is_windowed(policy, size) && !(policy.pool && size >= policy.parallel_threshold))
+			radix_order(less);
+		else
+			sort(less, policy, compare_keys_tag());
+	}
+
+	//LSD radix sort of the extracted keys, then the values are moved into key order
+	void radix_order(Compare& less)
+	{
+		std::vector<radix_entry<radix_traits::word_count>, resource_allocator<radix_entry<radix_traits::word_count>>> entries(
+			ordered_values.size(), radix_entry<radix_traits::word_count>(), ordered_values.get_allocator());
+		for (std::size_t i = 0; i < entries.size(); ++i)
+		{
+			radix_traits::encode(less.key(ordered_values[i]), entries[i].words);
+			entries[i].position = i;
+		}
+		radix_sort(entries);
+
+		buffer_type sorted(ordered_values.get_allocator());
+		sorted.reserve(entries.size());
+		for (auto entry = entries.begin(); entry != entries.end(); ++entry)
+			sorted.push_back(std::move(ordered_values[entry->position]));
+		ordered_values.swap(sorted);
+	}
+
+public:
+	order_by_enumerator(order_by_enumerator&& other)
+		: ordered_values(std::move(other.ordered_values))
+		,curr(std::move(other.curr))
+		,merge(std::move(other.merge))
+		,merge_skip(other.merge_skip)
+	{
+	}
+
+	order_by_enumerator(Source&& source, Compare const& compare, sort_policy const& policy = sort_policy())
+		: ordered_values(policy.resource)
+		, merge_skip(0)
+	{
+		Compare less = compare;
+		if (saturating_add(policy.skip, policy.prefix) <= small_prefix)
+		{
+			select_smallest(source, less, policy.skip, policy.prefix, sort_tag());
+		}
+		else
+		{
+			buffer(source, less, policy);
+			if (!merge)
+				sort(less, policy, sort_tag());
+		}
 		curr = ordered_values.begin();
 	}
 
 	bool move_first()
 	{
+		if (merge)
+		{
+			if (!merge->move_first())
+				return false;
+			for (std::size_t i = 0; i < merge_skip; ++i)
+			{
+				if (!merge->move_next())
+					return false;
+			}
+			return true;
+		}
 		return curr != ordered_values.end();
 	}
 
 	bool move_next()
 	{
+		if (merge)
+			return merge->move_next();
 		++curr;
 		return curr != ordered_values.end();
 	}
 
 	value_type current()
 	{
+		if (merge)
+			return merge->current();
 		return *curr;
 	}
 };
 
-}
+}
\ No newline at end of file
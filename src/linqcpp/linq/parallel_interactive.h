@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "optional.h"
+#include "size_hint.h"
+#include "partition_traits.h"
+#include "thread_pool.h"
+#include "where_enumerable.h"
+
+namespace linq {
+
+// Parallel reductions over an Enumerable<T>, obtained through interactive::parallel()
+// o Partitionable sources (from() over random access ranges, then select/where) are split into chunks
+//   that are reduced on the pool's workers, and the partial results are combined in source order
+// o Other sources are reduced sequentially on the calling thread
+// o aggregate(seed, func, combine) applies seed to every chunk, so seed must be an identity of combine
+template <typename Enumerable>
+class parallel_interactive
+{
+public:
+	typedef Enumerable enumerable_type;
+	typedef typename enumerable_type::enumerator_type enumerator_type;
+	typedef typename enumerable_type::value_type value_type;
+	typedef typename std::decay<value_type>::type result_type;
+
+private:
+	enumerable_type source;
+	thread_pool* pool;
+	std::size_t min_chunk_size;
+
+	parallel_interactive(parallel_interactive const& other); // not defined
+	parallel_interactive& operator=(parallel_interactive const& other); // not defined
+
+	//reduces each chunk with reduce_chunk(enumerator_type&) and folds the partials left to right with combine
+	template <typename Partial, typename ReduceChunk, typename Combine>
+	Partial reduce(Partial identity, ReduceChunk const& reduce_chunk, Combine const& combine, std::true_type)
+	{
+		std::size_t size = source.partition_size();
+		std::size_t chunk_count = std::min(
+			pool->worker_count() * 4,
+			(size + min_chunk_size - 1) / min_chunk_size);
+		if (chunk_count <= 1)
+			return reduce(std::move(identity), reduce_chunk, combine, std::false_type());
+
+		std::vector<Partial> partials(chunk_count, identity);
+		{
+			task_group group(*pool);
+			for (std::size_t i = 0; i < chunk_count; ++i)
+			{
+				group.run([&, i]()
+				{
+					auto e = source.get_partition(i * size / chunk_count, (i + 1) * size / chunk_count);
+					partials[i] = reduce_chunk(e);
+				});
+			}
+			group.wait();
+		}
+
+		Partial result = std::move(partials[0]);
+		for (std::size_t i = 1; i < chunk_count; ++i)
+			result = combine(std::move(result), std::move(partials[i]));
+		return result;
+	}
+
+	template <typename Partial, typename ReduceChunk, typename Combine>
+	Partial reduce(Partial, ReduceChunk const& reduce_chunk, Combine const&, std::false_type)
+	{
+		auto e = source.get_enumerator();
+		return reduce_chunk(e);
+	}
+
+	template <typename Partial, typename ReduceChunk, typename Combine>
+	Partial reduce(Partial identity, ReduceChunk const& reduce_chunk, Combine const& combine)
+	{
+		return reduce(std::move(identity), reduce_chunk, combine,
+			std::integral_constant<bool, partition_traits<enumerable_type>::is_partitionable>());
+	}
+
+	//min/max/minmax partials are empty for chunks that produced no values
+	template <typename Compare>
+	struct min_combine
+	{
+		Compare compare;
+		optional<result_type> operator()(optional<result_type>&& a, optional<result_type>&& b) const
+		{
+			if (!a)
+				return std::move(b);
+			if (b && compare(b.value(), a.value()))
+				return std::move(b);
+			return std::move(a);
+		}
+	};
+
+	template <typename Compare>
+	optional<result_type> extreme(Compare const& compare)
+	{
+		return reduce(optional<result_type>(), [&](enumerator_type& e) -> optional<result_type>
+		{
+			if (!e.move_first())
+				return optional<result_type>();
+			result_type best = e.current();
+			while (e.move_next())
+			{
+				result_type current = e.current();
+				if (compare(current, best))
+					best = std::move(current);
+			}
+			return optional<result_type>(std::move(best));
+		}, min_combine<Compare>{ compare });
+	}
+
+	//an empty sequence fails like the serial min, max and minmax (through move_first_or_throw)
+	template <typename T>
+	static T value_or_throw(optional<T>&& value)
+	{
+		if (!value)
+			throw new std::logic_error("move_first returned false");
+		return std::move(value.value());
+	}
+
+public:
+	parallel_interactive(parallel_interactive&& other)
+		: source(std::move(other.source))
+		, pool(other.pool)
+		, min_chunk_size(other.min_chunk_size)
+	{
+	}
+
+	parallel_interactive(enumerable_type&& source, thread_pool& pool, std::size_t min_chunk_size)
+		: source(std::move(source))
+		, pool(&pool)
+		, min_chunk_size(min_chunk_size == 0 ? 1 : min_chunk_size)
+	{
+	}
+
+	template <typename T, typename BinaryOperation, typename Combine>
+	T aggregate(T seed, BinaryOperation const& func, Combine const& combine)
+	{
+		return reduce(seed, [&](enumerator_type& e) -> T
+		{
+			T value = seed;
+			if (!e.move_first())
+				return value;
+			do
+			{
+				value = func(value, e.current());
+			} while (e.move_next());
+			return value;
+		}, combine);
+	}
+
+	//combines the partial results with func itself, so func must accept (T, T)
+	template <typename T, typename BinaryOperation>
+	T aggregate(T seed, BinaryOperation const& func)
+	{
+		return aggregate(seed, func, func);
+	}
+
+	result_type sum()
+	{
+		return aggregate(static_cast<result_type>(0), std::plus<result_type>());
+	}
+
+	std::size_t count()
+	{
+		size_hint hint = get_size_hint(source);
+		if (hint.is_exact())
+			return hint.size();
+		return reduce(static_cast<std::size_t>(0), [](enumerator_type& e) -> std::size_t
+		{
+			if (!e.move_first())
+				return 0;
+			std::size_t n = 1;
+			while (e.move_next())
+				++n;
+			return n;
+		}, std::plus<std::size_t>());
+	}
+
+	template <typename Predicate>
+	std::size_t count_if(Predicate const& predicate)
+	{
+		return parallel_interactive<where_enumerable<enumerable_type, Predicate>>(
+			where_enumerable<enumerable_type, Predicate>(std::move(source), predicate),
+			*pool,
+			min_chunk_size).count();
+	}
+
+	result_type min()
+	{
+		return value_or_throw(extreme(std::less<result_type>()));
+	}
+
+	result_type max()
+	{
+		return value_or_throw(extreme(std::greater<result_type>()));
+	}
+
+	std::pair<result_type, result_type> minmax()
+	{
+		typedef std::pair<result_type, result_type> range_type;
+		optional<range_type> range = reduce(optional<range_type>(), [](enumerator_type& e) -> optional<range_type>
+		{
+			if (!e.move_first())
+				return optional<range_type>();
+			result_type min_value = e.current();
+			result_type max_value = min_value;
+			while (e.move_next())
+			{
+				result_type current = e.current();
+				if (current < min_value)
+					min_value = current;
+				else if (max_value < current)
+					max_value = current;
+			}
+			return optional<range_type>(range_type(min_value, max_value));
+		}, [](optional<range_type>&& a, optional<range_type>&& b) -> optional<range_type>
+		{
+			if (!a)
+				return std::move(b);
+			if (!b)
+				return std::move(a);
+			return optional<range_type>(range_type(
+				b.value().first < a.value().first ? b.value().first : a.value().first,
+				a.value().second < b.value().second ? b.value().second : a.value().second));
+		});
+		return value_or_throw(std::move(range));
+	}
+};
+
+}
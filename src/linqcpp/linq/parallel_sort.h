@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.h"
+#include "adaptive_sort.h"
+
+namespace linq {
+
+namespace parallel_sort_detail {
+
+	//stable merge of [a_first, a_last) and [b_first, b_last) into out, split into up to "pieces" tasks;
+	//ties go to the a side, exactly as std::merge
+	template <typename Iterator, typename OutIterator, typename Compare>
+	void merge(task_group& group, Iterator a_first, Iterator a_last, Iterator b_first, Iterator b_last, OutIterator out, Compare const& compare, std::size_t pieces)
+	{
+		std::size_t a_size = static_cast<std::size_t>(a_last - a_first);
+		if (pieces <= 1 || a_size < 2)
+		{
+			group.run([=]()
+			{
+				std::merge(
+					std::make_move_iterator(a_first), std::make_move_iterator(a_last),
+					std::make_move_iterator(b_first), std::make_move_iterator(b_last),
+					out, compare);
+			});
+			return;
+		}
+
+		//a[0, i) and the b values strictly less than a[i] come first
+		Iterator a_middle = a_first + a_size / 2;
+		Iterator b_middle = std::lower_bound(b_first, b_last, *a_middle, compare);
+		OutIterator out_middle = out + ((a_middle - a_first) + (b_middle - b_first));
+		merge(group, a_first, a_middle, b_first, b_middle, out, compare, pieces / 2);
+		merge(group, a_middle, a_last, b_middle, b_last, out_middle, compare, pieces - pieces / 2);
+	}
+
+}
+
+// Stable sort of [first, last) on pool: one sorted run per worker, then rounds of pairwise parallel merges
+// o Produces exactly the order of std::stable_sort
+template <typename Iterator, typename Compare>
+void parallel_stable_sort(Iterator first, Iterator last, Compare compare, thread_pool& pool)
+{
+	typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+	std::size_t size = static_cast<std::size_t>(last - first);
+	std::size_t run_count = pool.worker_count();
+	if (run_count <= 1 || size < 2 * run_count)
+	{
+		adaptive_stable_sort(first, last, compare);
+		return;
+	}
+
+	std::vector<std::size_t> bounds;
+	for (std::size_t i = 0; i <= run_count; ++i)
+		bounds.push_back(i * size / run_count);
+
+	{
+		task_group group(pool);
+		for (std::size_t i = 0; i < run_count; ++i)
+		{
+			Iterator run_first = first + bounds[i];
+			Iterator run_last = first + bounds[i + 1];
+			group.run([=]()
+			{
+				adaptive_stable_sort(run_first, run_last, compare);
+			});
+		}
+		group.wait();
+	}
+
+	//merge adjacent runs back and forth between the input and a buffer until one run remains
+	std::vector<value_type> buffer(std::make_move_iterator(first), std::make_move_iterator(last));
+	bool in_buffer = true;
+	while (bounds.size() > 2)
+	{
+		std::vector<std::size_t> merged_bounds;
+		std::size_t merge_count = (bounds.size() - 1) / 2;
+		std::size_t pieces = (run_count + merge_count - 1) / merge_count;
+		{
+			task_group group(pool);
+			for (std::size_t i = 0; i + 1 < bounds.size(); i += 2)
+			{
+				merged_bounds.push_back(bounds[i]);
+				if (i + 2 >= bounds.size())
+				{
+					//odd run out, carried over unchanged
+					if (in_buffer)
+						std::move(buffer.begin() + bounds[i], buffer.begin() + bounds[i + 1], first + bounds[i]);
+					else
+						std::move(first + bounds[i], first + bounds[i + 1], buffer.begin() + bounds[i]);
+					continue;
+				}
+				if (in_buffer)
+					parallel_sort_detail::merge(group,
+						buffer.begin() + bounds[i], buffer.begin() + bounds[i + 1],
+						buffer.begin() + bounds[i + 1], buffer.begin() + bounds[i + 2],
+						first + bounds[i], compare, pieces);
+				else
+					parallel_sort_detail::merge(group,
+						first + bounds[i], first + bounds[i + 1],
+						first + bounds[i + 1], first + bounds[i + 2],
+						buffer.begin() + bounds[i], compare, pieces);
+			}
+			group.wait();
+		}
+		merged_bounds.push_back(size);
+		bounds.swap(merged_bounds);
+		in_buffer = !in_buffer;
+	}
+
+	if (in_buffer)
+		std::move(buffer.begin(), buffer.end(), first);
+}
+
+}
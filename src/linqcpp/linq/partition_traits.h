@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+// Optional extension of concept Enumerable<T>: partitioning, used by the parallel operators
+// o std::size_t partition_size()
+//   o Returns the number of positions in the underlying random access source
+// o enumerator_type get_partition(std::size_t begin, std::size_t end)
+//   o Returns an enumerator over the values produced by source positions [begin, end)
+//   o Concatenating the partitions of [0, partition_size()) in order gives the whole sequence
+//   o May be called concurrently from several threads
+// o Enumerables opt in by specializing partition_traits with is_partitionable == true
+
+namespace linq {
+
+template <typename Enumerable>
+struct partition_traits
+{
+	static const bool is_partitionable = false;
+};
+
+}
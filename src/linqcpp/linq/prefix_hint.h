@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+// Optional extension of concept Enumerable<T>: prefix hints
+// o void set_prefix_hint(std::size_t count)
+//   o Promises that no enumerator will be asked for more than the first count values
+//   o Lets buffering operators (order_by) skip ordering values that will never be reached
+//   o Repeated hints keep the smallest count
+//   o The promise holds for every later enumerator, so only an operator that takes ownership of the enumerable (take)
+//     may make it; terminal operators such as first leave their source unhinted
+// o Enumerables without set_prefix_hint ignore the hint
+// o std::size_t drop_prefix(std::size_t count)
+//   o Asks that every enumerator leave out the first count values; returns how many of them it will leave out (the
+//     caller skips the rest itself)
+//   o Lets order_by order only a window of values, and not the values before it that skip would throw away
+//   o Later prefix hints count from the first value that is not left out
+//   o Like set_prefix_hint, only an operator that takes ownership of the enumerable (skip) may ask
+// o Enumerables without drop_prefix leave out nothing
+
+namespace linq {
+
+namespace prefix_lookup {
+
+	template <typename Enumerable>
+	auto set_prefix_hint(Enumerable& enumerable, std::size_t count, int) -> decltype(enumerable.set_prefix_hint(count))
+	{
+		return enumerable.set_prefix_hint(count);
+	}
+
+	template <typename Enumerable>
+	void set_prefix_hint(Enumerable&, std::size_t, long)
+	{
+	}
+
+
+	template <typename Enumerable>
+	auto drop_prefix(Enumerable& enumerable, std::size_t count, int) -> decltype(enumerable.drop_prefix(count))
+	{
+		return enumerable.drop_prefix(count);
+	}
+
+	template <typename Enumerable>
+	std::size_t drop_prefix(Enumerable&, std::size_t, long)
+	{
+		return 0;
+	}
+
+}
+
+template <typename Enumerable>
+void set_prefix_hint(Enumerable& enumerable, std::size_t count)
+{
+	prefix_lookup::set_prefix_hint(enumerable, count, 0);
+}
+
+template <typename Enumerable>
+std::size_t drop_prefix(Enumerable& enumerable, std::size_t count)
+{
+	return prefix_lookup::drop_prefix(enumerable, count, 0);
+}
+
+//a + b, saturating at the largest std::size_t (used for "no limit")
+inline std::size_t saturating_add(std::size_t a, std::size_t b)
+{
+	return a > std::numeric_limits<std::size_t>::max() - b ? std::numeric_limits<std::size_t>::max() : a + b;
+}
+
+}
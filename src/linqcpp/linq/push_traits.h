@@ -0,0 +1,72 @@
+#pragma once
+
+#include <utility>
+
+// Optional extension of concept Enumerable<T>: push (sink-driven) enumeration
+// o template <typename Sink> bool push(Sink& sink)
+//   o Calls sink(value) for each value in order, as a single loop instead of through an Enumerator<T>
+//   o sink returns false to stop the enumeration early
+//   o Returns false if and only if sink stopped the enumeration
+// o Enumerables without push are driven through get_enumerator() instead
+//
+// Concept Sink<T>
+// o bool operator()(T value)
+//   o Returns true if and only if the sink wants more values
+
+namespace linq {
+
+namespace push_lookup {
+
+	//accepts anything, only used to detect push members
+	struct any_sink
+	{
+		template <typename T>
+		bool operator()(T&&)
+		{
+			return true;
+		}
+	};
+
+	template <typename Enumerable, typename Sink>
+	auto push(Enumerable& enumerable, Sink& sink, int) -> decltype(enumerable.push(sink))
+	{
+		return enumerable.push(sink);
+	}
+
+	template <typename Enumerable, typename Sink>
+	bool push(Enumerable& enumerable, Sink& sink, long)
+	{
+		auto e = enumerable.get_enumerator();
+		if (!e.move_first())
+			return true;
+		while (true)
+		{
+			if (!sink(e.current()))
+				return false;
+			if (!e.move_next())
+				return true;
+		}
+	}
+
+	template <typename Enumerable>
+	auto has_push(Enumerable& enumerable, any_sink& sink, int) -> decltype(enumerable.push(sink), std::true_type());
+
+	template <typename Enumerable>
+	std::false_type has_push(Enumerable& enumerable, any_sink& sink, long);
+
+}
+
+template <typename Enumerable>
+struct push_traits
+{
+	static const bool is_pushed = decltype(push_lookup::has_push(std::declval<Enumerable&>(), std::declval<push_lookup::any_sink&>(), 0))::value;
+};
+
+//drives sink from enumerable, using its push member if it has one
+template <typename Enumerable, typename Sink>
+bool push(Enumerable& enumerable, Sink& sink)
+{
+	return push_lookup::push(enumerable, sink, 0);
+}
+
+}
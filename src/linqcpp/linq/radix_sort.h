@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "descending_selector.h"
+
+namespace linq {
+
+// Order preserving encoding of sort keys as unsigned 64 bit words, most significant word first
+// o radix_key_traits<Key>::is_radixable for integers, IEEE float and double, and descending_key, std::pair and std::tuple of those
+// o word_count: the number of words one key encodes to
+// o static void encode(Key const& key, std::uint64_t* words)
+//   o Writes word_count words, so that keys compare with < exactly as their words compare lexicographically
+//   o -0.0 encodes as 0.0, since they are equal keys
+template <typename Key, typename Enable = void>
+struct radix_key_traits
+{
+	static const bool is_radixable = false;
+	static const std::size_t word_count = 0;
+};
+
+template <typename Key>
+struct radix_key_traits<Key, typename std::enable_if<std::is_integral<Key>::value>::type>
+{
+	static const bool is_radixable = true;
+	static const std::size_t word_count = 1;
+
+	static void encode(Key key, std::uint64_t* words)
+	{
+		encode(key, words, std::is_signed<Key>());
+	}
+
+private:
+	//flipping the sign bit orders negative values before positive ones
+	static void encode(Key key, std::uint64_t* words, std::true_type)
+	{
+		words[0] = static_cast<std::uint64_t>(static_cast<std::int64_t>(key)) ^ (static_cast<std::uint64_t>(1) << 63);
+	}
+
+	static void encode(Key key, std::uint64_t* words, std::false_type)
+	{
+		words[0] = static_cast<std::uint64_t>(key);
+	}
+};
+
+template <typename Key>
+struct radix_key_traits<Key, typename std::enable_if<
+	std::is_floating_point<Key>::value
+	&& std::numeric_limits<Key>::is_iec559
+	&& (sizeof(Key) == 4 || sizeof(Key) == 8)>::type>
+{
+	static const bool is_radixable = true;
+	static const std::size_t word_count = 1;
+
+	//negative values have every bit flipped (larger magnitudes come first), others only the sign bit
+	static void encode(Key key, std::uint64_t* words)
+	{
+		typedef typename std::conditional<sizeof(Key) == 4, std::uint32_t, std::uint64_t>::type bits_type;
+		if (key == 0)
+			key = 0;
+		bits_type bits;
+		std::memcpy(&bits, &key, sizeof(bits));
+		bits_type sign = static_cast<bits_type>(1) << (sizeof(bits_type) * 8 - 1);
+		words[0] = (bits & sign) ? static_cast<bits_type>(~bits) : static_cast<bits_type>(bits | sign);
+	}
+};
+
+template <typename First, typename Second>
+struct radix_key_traits<std::pair<First, Second>, typename std::enable_if<
+	radix_key_traits<typename std::decay<First>::type>::is_radixable
+	&& radix_key_traits<typename std::decay<Second>::type>::is_radixable>::type>
+{
+	typedef radix_key_traits<typename std::decay<First>::type> first_traits;
+	typedef radix_key_traits<typename std::decay<Second>::type> second_traits;
+
+	static const bool is_radixable = true;
+	static const std::size_t word_count = first_traits::word_count + second_traits::word_count;
+
+	static void encode(std::pair<First, Second> const& key, std::uint64_t* words)
+	{
+		first_traits::encode(key.first, words);
+		second_traits::encode(key.second, words + first_traits::word_count);
+	}
+};
+
+//the complemented words order in reverse
+template <typename Key>
+struct radix_key_traits<descending_key<Key>, typename std::enable_if<radix_key_traits<Key>::is_radixable>::type>
+{
+	typedef radix_key_traits<Key> key_traits;
+
+	static const bool is_radixable = true;
+	static const std::size_t word_count = key_traits::word_count;
+
+	static void encode(descending_key<Key> const& key, std::uint64_t* words)
+	{
+		key_traits::encode(key.key, words);
+		for (std::size_t i = 0; i < word_count; ++i)
+			words[i] = ~words[i];
+	}
+};
+
+namespace radix_detail {
+
+	template <typename Tuple, std::size_t Index = 0, std::size_t Size = std::tuple_size<Tuple>::value>
+	struct tuple_key
+	{
+		typedef radix_key_traits<typename std::decay<typename std::tuple_element<Index, Tuple>::type>::type> element_traits;
+		typedef tuple_key<Tuple, Index + 1, Size> rest;
+
+		static const bool is_radixable = element_traits::is_radixable && rest::is_radixable;
+		static const std::size_t word_count = element_traits::word_count + rest::word_count;
+
+		static void encode(Tuple const& key, std::uint64_t* words)
+		{
+			element_traits::encode(std::get<Index>(key), words);
+			rest::encode(key, words + element_traits::word_count);
+		}
+	};
+
+	template <typename Tuple, std::size_t Size>
+	struct tuple_key<Tuple, Size, Size>
+	{
+		static const bool is_radixable = true;
+		static const std::size_t word_count = 0;
+
+		static void encode(Tuple const&, std::uint64_t*)
+		{
+		}
+	};
+
+}
+
+template <typename... Keys>
+struct radix_key_traits<std::tuple<Keys...>, typename std::enable_if<radix_detail::tuple_key<std::tuple<Keys...>>::is_radixable>::type>
+	: radix_detail::tuple_key<std::tuple<Keys...>>
+{
+};
+
+// An encoded key and the source position of the value it came from
+template <std::size_t WordCount>
+struct radix_entry
+{
+	std::uint64_t words[WordCount];
+	std::size_t position;
+};
+
+namespace radix_detail {
+
+	//digit 0 holds the least significant DigitBits bits of the last word; digits do not straddle words
+	template <std::size_t DigitBits, std::size_t WordCount>
+	inline std::size_t digit(radix_entry<WordCount> const& entry, std::size_t index)
+	{
+		const std::size_t digits_per_word = (64 + DigitBits - 1) / DigitBits;
+		return static_cast<std::size_t>((entry.words[WordCount - 1 - index / digits_per_word] >> (DigitBits * (index % digits_per_word)))
+			& ((static_cast<std::uint64_t>(1) << DigitBits) - 1));
+	}
+
+	template <std::size_t DigitBits, std::size_t WordCount, typename Allocator>
+	void radix_sort(std::vector<radix_entry<WordCount>, Allocator>& entries)
+	{
+		const std::size_t digit_count = WordCount * ((64 + DigitBits - 1) / DigitBits);
+		const std::size_t bucket_count = static_cast<std::size_t>(1) << DigitBits;
+		const std::size_t size = entries.size();
+
+		std::vector<std::size_t> counts(digit_count * bucket_count);
+		for (auto entry = entries.begin(); entry != entries.end(); ++entry)
+		{
+			for (std::size_t d = 0; d < digit_count; ++d)
+				++counts[d * bucket_count + digit<DigitBits>(*entry, d)];
+		}
+
+		std::vector<radix_entry<WordCount>, Allocator> buffer(entries.get_allocator());
+		std::vector<radix_entry<WordCount>, Allocator>* from = &entries;
+		std::vector<radix_entry<WordCount>, Allocator>* to = &buffer;
+		for (std::size_t d = 0; d < digit_count; ++d)
+		{
+			std::size_t* count = &counts[d * bucket_count];
+			if (count[digit<DigitBits>(entries.front(), d)] == size)
+				continue;
+
+			std::size_t offset = 0;
+			for (std::size_t i = 0; i < bucket_count; ++i)
+			{
+				std::size_t n = count[i];
+				count[i] = offset;
+				offset += n;
+			}
+
+			if (to->empty())
+				to->resize(size);
+			radix_entry<WordCount>* out = &to->front();
+			for (auto entry = from->begin(); entry != from->end(); ++entry)
+				out[count[digit<DigitBits>(*entry, d)]++] = *entry;
+			std::swap(from, to);
+		}
+
+		if (from != &entries)
+			entries.swap(buffer);
+	}
+
+}
+
+// Stable LSD radix sort of entries by their words
+// o Already sorted input is detected (in one pass) and left as it is
+// o Every digit is counted in a single pass up front
+// o Passes over digits that are the same in every entry are skipped, so narrow keys cost only the digits they use
+// o Large inputs use 16 bit digits (fewer passes), smaller ones 11 bit digits (histograms that stay in cache)
+// o The scatter buffer is allocated with the allocator of entries
+template <std::size_t WordCount, typename Allocator>
+void radix_sort(std::vector<radix_entry<WordCount>, Allocator>& entries)
+{
+	if (entries.size() < 2)
+		return;
+	auto words_less = [](radix_entry<WordCount> const& a, radix_entry<WordCount> const& b)
+	{
+		return std::lexicographical_compare(a.words, a.words + WordCount, b.words, b.words + WordCount);
+	};
+	if (std::is_sorted(entries.begin(), entries.end(), words_less))
+		return;
+	if (entries.size() >= (static_cast<std::size_t>(1) << 20))
+		radix_detail::radix_sort<16>(entries);
+	else
+		radix_detail::radix_sort<11>(entries);
+}
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+
+// Optional extension of concept Enumerator<T>: random access
+// o std::size_t size()
+//   o Returns the number of values the enumerator has yet to produce
+// o void advance(std::size_t count)
+//   o Drops the next count values, where count <= size()
+// o value_type at(std::size_t index)
+//   o Returns the value index positions ahead, where index < size()
+// o Only valid on a fresh enumerator (before move_first), which advance leaves fresh
+// o Enumerators opt in by specializing random_access_traits with is_random_access == true
+
+namespace linq {
+
+template <typename Enumerator>
+struct random_access_traits
+{
+	static const bool is_random_access = false;
+};
+
+}
@@ -1,13 +1,13 @@
 #pragma once
 
-#include "make_unique.h"
 #include "enumerable.h"
+#include "size_hint.h"
 #include "return_enumerator.h"
 
 namespace linq {
 
 template <typename T>
-class return_enumerable : public enumerable<typename return_enumerator<T>::value_type>
+class return_enumerable
 {
 public:
 	typedef return_enumerator<T> enumerator_type;
@@ -35,14 +35,14 @@ public:
 		return enumerator_type(value);
 	}
 
-	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
+	size_hint get_size_hint()
 	{
-		return make_unique<enumerator_type>(std::move(get_enumerator()));
+		return size_hint::exact(1);
 	}
 };
 
 template <typename T>
-class return_enumerable<T&> : public enumerable<typename return_enumerator<T>::value_type>
+class return_enumerable<T&>
 {
 public:
 	typedef return_enumerator<T> enumerator_type;
@@ -70,9 +70,9 @@ public:
 		return enumerator_type(value);
 	}
 
-	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
+	size_hint get_size_hint()
 	{
-		return make_unique<enumerator_type>(std::move(get_enumerator()));
+		return size_hint::exact(1);
 	}
 };
 
@@ -7,7 +7,7 @@
 namespace linq {
 
 template <typename T>
-class return_enumerator : public enumerator<T&>
+class return_enumerator
 {
 public:
 	typedef T& value_type;
@@ -1,13 +1,16 @@
 #pragma once
 
-#include "make_unique.h"
 #include "enumerable.h"
+#include "size_hint.h"
+#include "prefix_hint.h"
+#include "push_traits.h"
+#include "partition_traits.h"
 #include "select_enumerator.h"
 
 namespace linq {
 
 template <typename Source, typename Selector>
-class select_enumerable : public enumerable<typename select_enumerator<typename Source::enumerator_type, Selector>::value_type>
+class select_enumerable
 {
 public:
 	typedef select_enumerator<typename Source::enumerator_type, Selector> enumerator_type;
@@ -38,10 +41,43 @@ public:
 		return enumerator_type(std::move(source.get_enumerator()), selector);
 	}
 
-	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
+	std::size_t partition_size()
 	{
-		return make_unique<enumerator_type>(std::move(get_enumerator()));
+		return source.partition_size();
 	}
+
+	enumerator_type get_partition(std::size_t first, std::size_t last)
+	{
+		return enumerator_type(std::move(source.get_partition(first, last)), selector);
+	}
+
+	size_hint get_size_hint()
+	{
+		return linq::get_size_hint(source);
+	}
+
+	void set_prefix_hint(std::size_t count)
+	{
+		linq::set_prefix_hint(source, count);
+	}
+
+	template <typename Sink>
+	bool push(Sink& sink)
+	{
+		typedef typename Source::value_type source_value_type;
+		Selector selector = this->selector;
+		auto select_sink = [&](source_value_type value)
+		{
+			return sink(selector(std::forward<source_value_type>(value)));
+		};
+		return linq::push(source, select_sink);
+	}
+};
+
+template <typename Source, typename Selector>
+struct partition_traits<select_enumerable<Source, Selector>>
+{
+	static const bool is_partitionable = partition_traits<Source>::is_partitionable;
 };
 
 }
\ No newline at end of file
@@ -1,11 +1,18 @@
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+
 #include "enumerator.h"
+#include "batch_traits.h"
+#include "random_access_traits.h"
+#include "contiguous_traits.h"
+#include "expression.h"
 
 namespace linq {
 
 template <typename Source, typename Selector>
-class select_enumerator : public enumerator<typename std::result_of<Selector(typename Source::value_type)>::type>
+class select_enumerator
 {
 public:
 	typedef typename std::result_of<Selector(typename Source::value_type)>::type value_type;
@@ -44,6 +51,104 @@ public:
 	{
 		return selector(source.current());
 	}
+
+private:
+	typedef typename batch_traits<Source>::batch_type source_batch_type;
+	typedef typename batch_traits<select_enumerator>::batch_type batch_type;
+
+	//a block evaluable selector (see expression.h) is evaluated a block at a time
+	void transform(source_batch_type const* data, std::size_t size, batch_type* out, std::true_type)
+	{
+		for (std::size_t first = 0; first < size; first += simd::block_size)
+		{
+			selector.evaluate(data + first, std::min(simd::block_size, size - first), out + first);
+		}
+	}
+
+	void transform(source_batch_type const* data, std::size_t size, batch_type* out, std::false_type)
+	{
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			out[i] = selector(data[i]);
+		}
+	}
+
+	void transform(source_batch_type const* data, std::size_t size, batch_type* out)
+	{
+		typedef block_evaluation_traits<Selector, source_batch_type> evaluation_traits;
+		typedef std::integral_constant<bool, evaluation_traits::is_block_evaluable && std::is_same<typename evaluation_traits::lane_type, batch_type>::value> is_block_evaluable;
+		transform(data, size, out, is_block_evaluable());
+	}
+
+	//select straight from the source's storage
+	std::size_t next_batch(batch_type* buffer, std::size_t capacity, std::true_type)
+	{
+		std::size_t count = std::min(capacity, source.size());
+		if (count != 0)
+		{
+			transform(&source.at(0), count, buffer);
+			source.advance(count);
+		}
+		return count;
+	}
+
+	std::size_t next_batch(batch_type* buffer, std::size_t capacity, std::false_type)
+	{
+		static const std::size_t source_capacity = batch_capacity<source_batch_type>::value;
+		source_batch_type source_buffer[source_capacity];
+
+		std::size_t count = 0;
+		while (count < capacity)
+		{
+			std::size_t requested = capacity - count < source_capacity ? capacity - count : source_capacity;
+			std::size_t received = source.next_batch(source_buffer, requested);
+			transform(source_buffer, received, buffer + count);
+			count += received;
+			if (received < requested)
+			{
+				break;
+			}
+		}
+		return count;
+	}
+
+public:
+	std::size_t next_batch(typename batch_traits<select_enumerator>::batch_type* buffer, std::size_t capacity)
+	{
+		return next_batch(buffer, capacity, std::integral_constant<bool, contiguous_traits<Source>::is_contiguous>());
+	}
+
+	std::size_t size()
+	{
+		return source.size();
+	}
+
+	void advance(std::size_t count)
+	{
+		source.advance(count);
+	}
+
+	value_type at(std::size_t index)
+	{
+		return selector(source.at(index));
+	}
+};
+
+//batched only when the selector cannot observe that it is handed a buffered copy instead of the source value
+template <typename Source, typename Selector>
+struct batch_traits<select_enumerator<Source, Selector>>
+{
+	typedef typename std::decay<typename select_enumerator<Source, Selector>::value_type>::type batch_type;
+	static const bool is_batched =
+		batch_traits<Source>::is_batched &&
+		is_batch_callable<Selector, typename batch_traits<Source>::batch_type const&>::value &&
+		std::is_trivial<batch_type>::value;
+};
+
+template <typename Source, typename Selector>
+struct random_access_traits<select_enumerator<Source, Selector>>
+{
+	static const bool is_random_access = random_access_traits<Source>::is_random_access;
 };
 
 }
\ No newline at end of file
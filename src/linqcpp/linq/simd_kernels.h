@@ -0,0 +1,692 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define LINQ_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define LINQ_TARGET_AVX2
+#else
+#define LINQ_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define LINQ_SIMD_X86 0
+#endif
+
+// Reduction kernels over arrays of arithmetic values, dispatched at runtime on the CPU's instruction set
+// o x86-64: AVX2 if the CPU (and OS) support it, SSE2 otherwise; other targets: portable scalar code
+// o Floating point sums are pairwise: blocks of block_size values are summed in lane_count interleaved lanes, the
+//   lanes in a fixed tree, and the block sums in a binary tree. Every instruction set adds in the same order, so a
+//   sum does not depend on the CPU, and its rounding error grows with log n instead of n
+// o Integer sums wrap around; minima and maxima are exactly those of comparing value by value with <
+// o Compaction copies the selected values of an array of 4 or 8 byte values with AVX2 permutes, anything else
+//   (and SSE2, which has no variable permute) with a branch-free scalar loop
+
+namespace linq {
+
+namespace simd {
+
+	enum level_type
+	{
+		scalar_level,
+		sse2_level,
+		avx2_level
+	};
+
+	inline level_type detect_level()
+	{
+#if LINQ_SIMD_X86
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return sse2_level;
+		__cpuid(info, 1);
+		bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+		__cpuidex(info, 7, 0);
+		return os_saves_ymm && (info[1] & (1 << 5)) != 0 ? avx2_level : sse2_level;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") ? avx2_level : sse2_level;
+#endif
+#else
+		return scalar_level;
+#endif
+	}
+
+	//the instruction set the kernels use: detected once, and may be lowered (e.g. to compare kernels), never raised
+	inline level_type& active_level()
+	{
+		static level_type level = detect_level();
+		return level;
+	}
+
+	static const std::size_t block_size = 256;
+	static const std::size_t lane_count = 16;
+
+	//the lanes of a block sum, added in a tree: lane i + lane i + 8, then i + 4, i + 2 and i + 1
+	template <typename T>
+	T reduce_lanes(T* lanes)
+	{
+		for (std::size_t width = lane_count / 2; width > 0; width /= 2)
+		{
+			for (std::size_t lane = 0; lane < width; ++lane)
+				lanes[lane] = lanes[lane] + lanes[lane + width];
+		}
+		return lanes[0];
+	}
+
+	//lane i sums data[i], data[i + lane_count], ... in order
+	template <typename T>
+	T sum_block_scalar(T const* data)
+	{
+		T lanes[lane_count];
+		for (std::size_t lane = 0; lane < lane_count; ++lane)
+			lanes[lane] = data[lane];
+		for (std::size_t i = lane_count; i < block_size; i += lane_count)
+		{
+			for (std::size_t lane = 0; lane < lane_count; ++lane)
+				lanes[lane] = lanes[lane] + data[i + lane];
+		}
+		return reduce_lanes(lanes);
+	}
+
+	template <typename T>
+	T wrapping_sum_scalar(T const* data, std::size_t size)
+	{
+		typedef typename std::make_unsigned<T>::type unsigned_type;
+		unsigned_type sum = 0;
+		for (std::size_t i = 0; i < size; ++i)
+			sum += static_cast<unsigned_type>(data[i]);
+		return static_cast<T>(sum);
+	}
+
+	template <typename T>
+	void minmax_block_scalar(T const* data, T& min, T& max, bool& unordered)
+	{
+		min = data[0];
+		max = data[0];
+		unordered = false;
+		for (std::size_t i = 0; i < block_size; ++i)
+		{
+			unordered = unordered || data[i] != data[i];
+			if (data[i] < min)
+				min = data[i];
+			if (max < data[i])
+				max = data[i];
+		}
+	}
+
+	//the least and greatest of count values stored from vector registers
+	template <typename T>
+	void minmax_lanes(T const* min_lanes, T const* max_lanes, std::size_t count, T& min, T& max)
+	{
+		min = min_lanes[0];
+		max = max_lanes[0];
+		for (std::size_t lane = 1; lane < count; ++lane)
+		{
+			if (min_lanes[lane] < min)
+				min = min_lanes[lane];
+			if (max < max_lanes[lane])
+				max = max_lanes[lane];
+		}
+	}
+
+	template <typename T>
+	std::size_t compact_scalar(T const* data, unsigned char const* selection, std::size_t size, T* out)
+	{
+		std::size_t count = 0;
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			out[count] = data[i];
+			count += selection[i];
+		}
+		return count;
+	}
+
+#if LINQ_SIMD_X86
+
+	inline float sum_block_sse2(float const* data)
+	{
+		__m128 a0 = _mm_loadu_ps(data);
+		__m128 a1 = _mm_loadu_ps(data + 4);
+		__m128 a2 = _mm_loadu_ps(data + 8);
+		__m128 a3 = _mm_loadu_ps(data + 12);
+		for (std::size_t i = lane_count; i < block_size; i += lane_count)
+		{
+			a0 = _mm_add_ps(a0, _mm_loadu_ps(data + i));
+			a1 = _mm_add_ps(a1, _mm_loadu_ps(data + i + 4));
+			a2 = _mm_add_ps(a2, _mm_loadu_ps(data + i + 8));
+			a3 = _mm_add_ps(a3, _mm_loadu_ps(data + i + 12));
+		}
+		__m128 sum4 = _mm_add_ps(_mm_add_ps(a0, a2), _mm_add_ps(a1, a3));
+		__m128 sum2 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+		return _mm_cvtss_f32(_mm_add_ss(sum2, _mm_shuffle_ps(sum2, sum2, 1)));
+	}
+
+	LINQ_TARGET_AVX2 inline float sum_block_avx2(float const* data)
+	{
+		__m256 a0 = _mm256_loadu_ps(data);
+		__m256 a1 = _mm256_loadu_ps(data + 8);
+		for (std::size_t i = lane_count; i < block_size; i += lane_count)
+		{
+			a0 = _mm256_add_ps(a0, _mm256_loadu_ps(data + i));
+			a1 = _mm256_add_ps(a1, _mm256_loadu_ps(data + i + 8));
+		}
+		__m256 sum8 = _mm256_add_ps(a0, a1);
+		__m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(sum8), _mm256_extractf128_ps(sum8, 1));
+		__m128 sum2 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+		return _mm_cvtss_f32(_mm_add_ss(sum2, _mm_shuffle_ps(sum2, sum2, 1)));
+	}
+
+	inline double sum_block_sse2(double const* data)
+	{
+		__m128d a[8];
+		for (std::size_t k = 0; k < 8; ++k)
+			a[k] = _mm_loadu_pd(data + 2 * k);
+		for (std::size_t i = lane_count; i < block_size; i += lane_count)
+		{
+			for (std::size_t k = 0; k < 8; ++k)
+				a[k] = _mm_add_pd(a[k], _mm_loadu_pd(data + i + 2 * k));
+		}
+		for (std::size_t k = 0; k < 4; ++k)
+			a[k] = _mm_add_pd(a[k], a[k + 4]);
+		__m128d sum2 = _mm_add_pd(_mm_add_pd(a[0], a[2]), _mm_add_pd(a[1], a[3]));
+		return _mm_cvtsd_f64(_mm_add_sd(sum2, _mm_unpackhi_pd(sum2, sum2)));
+	}
+
+	LINQ_TARGET_AVX2 inline double sum_block_avx2(double const* data)
+	{
+		__m256d a0 = _mm256_loadu_pd(data);
+		__m256d a1 = _mm256_loadu_pd(data + 4);
+		__m256d a2 = _mm256_loadu_pd(data + 8);
+		__m256d a3 = _mm256_loadu_pd(data + 12);
+		for (std::size_t i = lane_count; i < block_size; i += lane_count)
+		{
+			a0 = _mm256_add_pd(a0, _mm256_loadu_pd(data + i));
+			a1 = _mm256_add_pd(a1, _mm256_loadu_pd(data + i + 4));
+			a2 = _mm256_add_pd(a2, _mm256_loadu_pd(data + i + 8));
+			a3 = _mm256_add_pd(a3, _mm256_loadu_pd(data + i + 12));
+		}
+		__m256d sum4 = _mm256_add_pd(_mm256_add_pd(a0, a2), _mm256_add_pd(a1, a3));
+		__m128d sum2 = _mm_add_pd(_mm256_castpd256_pd128(sum4), _mm256_extractf128_pd(sum4, 1));
+		return _mm_cvtsd_f64(_mm_add_sd(sum2, _mm_unpackhi_pd(sum2, sum2)));
+	}
+
+	template <typename T>
+	T wrapping_sum_sse2(T const* data, std::size_t size)
+	{
+		__m128i sum = _mm_setzero_si128();
+		std::size_t i = 0;
+		for (; i + 16 / sizeof(T) <= size; i += 16 / sizeof(T))
+		{
+			__m128i values = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+			sum = sizeof(T) == 4 ? _mm_add_epi32(sum, values) : _mm_add_epi64(sum, values);
+		}
+		T lanes[16 / sizeof(T)];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sum);
+		T tail[2] = { wrapping_sum_scalar(lanes, 16 / sizeof(T)), wrapping_sum_scalar(data + i, size - i) };
+		return wrapping_sum_scalar(tail, 2);
+	}
+
+	template <typename T>
+	LINQ_TARGET_AVX2 T wrapping_sum_avx2(T const* data, std::size_t size)
+	{
+		__m256i sum = _mm256_setzero_si256();
+		std::size_t i = 0;
+		for (; i + 32 / sizeof(T) <= size; i += 32 / sizeof(T))
+		{
+			__m256i values = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i));
+			sum = sizeof(T) == 4 ? _mm256_add_epi32(sum, values) : _mm256_add_epi64(sum, values);
+		}
+		T lanes[32 / sizeof(T)];
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), sum);
+		T tail[2] = { wrapping_sum_scalar(lanes, 32 / sizeof(T)), wrapping_sum_scalar(data + i, size - i) };
+		return wrapping_sum_scalar(tail, 2);
+	}
+
+	inline void minmax_block_sse2(float const* data, float& min, float& max, bool& unordered)
+	{
+		__m128 low = _mm_loadu_ps(data);
+		__m128 high = low;
+		__m128 nan = _mm_cmpunord_ps(low, low);
+		for (std::size_t i = 4; i < block_size; i += 4)
+		{
+			__m128 values = _mm_loadu_ps(data + i);
+			low = _mm_min_ps(low, values);
+			high = _mm_max_ps(high, values);
+			nan = _mm_or_ps(nan, _mm_cmpunord_ps(values, values));
+		}
+		float min_lanes[4], max_lanes[4];
+		_mm_storeu_ps(min_lanes, low);
+		_mm_storeu_ps(max_lanes, high);
+		minmax_lanes(min_lanes, max_lanes, 4, min, max);
+		unordered = _mm_movemask_ps(nan) != 0;
+	}
+
+	LINQ_TARGET_AVX2 inline void minmax_block_avx2(float const* data, float& min, float& max, bool& unordered)
+	{
+		__m256 low = _mm256_loadu_ps(data);
+		__m256 high = low;
+		__m256 nan = _mm256_cmp_ps(low, low, _CMP_UNORD_Q);
+		for (std::size_t i = 8; i < block_size; i += 8)
+		{
+			__m256 values = _mm256_loadu_ps(data + i);
+			low = _mm256_min_ps(low, values);
+			high = _mm256_max_ps(high, values);
+			nan = _mm256_or_ps(nan, _mm256_cmp_ps(values, values, _CMP_UNORD_Q));
+		}
+		float min_lanes[8], max_lanes[8];
+		_mm256_storeu_ps(min_lanes, low);
+		_mm256_storeu_ps(max_lanes, high);
+		minmax_lanes(min_lanes, max_lanes, 8, min, max);
+		unordered = _mm256_movemask_ps(nan) != 0;
+	}
+
+	inline void minmax_block_sse2(double const* data, double& min, double& max, bool& unordered)
+	{
+		__m128d low = _mm_loadu_pd(data);
+		__m128d high = low;
+		__m128d nan = _mm_cmpunord_pd(low, low);
+		for (std::size_t i = 2; i < block_size; i += 2)
+		{
+			__m128d values = _mm_loadu_pd(data + i);
+			low = _mm_min_pd(low, values);
+			high = _mm_max_pd(high, values);
+			nan = _mm_or_pd(nan, _mm_cmpunord_pd(values, values));
+		}
+		double min_lanes[2], max_lanes[2];
+		_mm_storeu_pd(min_lanes, low);
+		_mm_storeu_pd(max_lanes, high);
+		minmax_lanes(min_lanes, max_lanes, 2, min, max);
+		unordered = _mm_movemask_pd(nan) != 0;
+	}
+
+	LINQ_TARGET_AVX2 inline void minmax_block_avx2(double const* data, double& min, double& max, bool& unordered)
+	{
+		__m256d low = _mm256_loadu_pd(data);
+		__m256d high = low;
+		__m256d nan = _mm256_cmp_pd(low, low, _CMP_UNORD_Q);
+		for (std::size_t i = 4; i < block_size; i += 4)
+		{
+			__m256d values = _mm256_loadu_pd(data + i);
+			low = _mm256_min_pd(low, values);
+			high = _mm256_max_pd(high, values);
+			nan = _mm256_or_pd(nan, _mm256_cmp_pd(values, values, _CMP_UNORD_Q));
+		}
+		double min_lanes[4], max_lanes[4];
+		_mm256_storeu_pd(min_lanes, low);
+		_mm256_storeu_pd(max_lanes, high);
+		minmax_lanes(min_lanes, max_lanes, 4, min, max);
+		unordered = _mm256_movemask_pd(nan) != 0;
+	}
+
+	//SSE2 has no 32 bit min/max, so they are blended from a comparison
+	template <typename T>
+	void minmax_block_sse2_int32(T const* data, T& min, T& max, bool& unordered)
+	{
+		__m128i low = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data));
+		__m128i high = low;
+		for (std::size_t i = 4; i < block_size; i += 4)
+		{
+			__m128i values = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+			__m128i less = _mm_cmplt_epi32(values, low);
+			low = _mm_or_si128(_mm_and_si128(less, values), _mm_andnot_si128(less, low));
+			__m128i greater = _mm_cmpgt_epi32(values, high);
+			high = _mm_or_si128(_mm_and_si128(greater, values), _mm_andnot_si128(greater, high));
+		}
+		T min_lanes[4], max_lanes[4];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(min_lanes), low);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(max_lanes), high);
+		minmax_lanes(min_lanes, max_lanes, 4, min, max);
+		unordered = false;
+	}
+
+	template <typename T>
+	LINQ_TARGET_AVX2 void minmax_block_avx2_int32(T const* data, T& min, T& max, bool& unordered)
+	{
+		__m256i low = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data));
+		__m256i high = low;
+		for (std::size_t i = 8; i < block_size; i += 8)
+		{
+			__m256i values = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i));
+			low = _mm256_min_epi32(low, values);
+			high = _mm256_max_epi32(high, values);
+		}
+		T min_lanes[8], max_lanes[8];
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(min_lanes), low);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(max_lanes), high);
+		minmax_lanes(min_lanes, max_lanes, 8, min, max);
+		unordered = false;
+	}
+
+	template <typename T>
+	LINQ_TARGET_AVX2 void minmax_block_avx2_int64(T const* data, T& min, T& max, bool& unordered)
+	{
+		__m256i low = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data));
+		__m256i high = low;
+		for (std::size_t i = 4; i < block_size; i += 4)
+		{
+			__m256i values = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i));
+			low = _mm256_blendv_epi8(low, values, _mm256_cmpgt_epi64(low, values));
+			high = _mm256_blendv_epi8(high, values, _mm256_cmpgt_epi64(values, high));
+		}
+		T min_lanes[4], max_lanes[4];
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(min_lanes), low);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(max_lanes), high);
+		minmax_lanes(min_lanes, max_lanes, 4, min, max);
+		unordered = false;
+	}
+
+	//for each mask of selected lanes, the 32 bit lanes to permute to the front, and how many are selected
+	struct compaction_tables
+	{
+		std::uint32_t order4[256][8];
+		std::uint32_t order8[16][8];
+		unsigned char counts[256];
+
+		compaction_tables()
+		{
+			for (unsigned mask = 0; mask < 256; ++mask)
+			{
+				unsigned count = 0;
+				for (unsigned lane = 0; lane < 8; ++lane)
+				{
+					if (mask & (1u << lane))
+						order4[mask][count++] = lane;
+				}
+				counts[mask] = static_cast<unsigned char>(count);
+				for (; count < 8; ++count)
+					order4[mask][count] = 0;
+			}
+			for (unsigned mask = 0; mask < 16; ++mask)
+			{
+				for (unsigned lane = 0; lane < 8; ++lane)
+					order8[mask][lane] = 2 * order4[mask][lane / 2] + lane % 2;
+			}
+		}
+
+		static compaction_tables const& get()
+		{
+			static compaction_tables tables;
+			return tables;
+		}
+	};
+
+	//16 selection bytes at a time become a bit mask, then each 256 bit vector of values is permuted by its part of the
+	//mask and stored whole at the output position; the lanes past the selected ones are overwritten later (or lie
+	//in the part of the input already read)
+	template <typename T>
+	LINQ_TARGET_AVX2 std::size_t compact_avx2(T const* data, unsigned char const* selection, std::size_t size, T* out)
+	{
+		static const std::size_t lanes = 32 / sizeof(T);
+		static const unsigned lane_mask = (1u << lanes) - 1;
+		compaction_tables const& tables = compaction_tables::get();
+		std::size_t count = 0;
+		std::size_t i = 0;
+		for (; i + 16 <= size; i += 16)
+		{
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(selection + i));
+			unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_slli_epi16(bytes, 7)));
+			for (std::size_t part = 0; part < 16; part += lanes, mask >>= lanes)
+			{
+				unsigned selected = mask & lane_mask;
+				__m256i values = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i + part));
+				__m256i order = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(sizeof(T) == 4 ? tables.order4[selected] : tables.order8[selected]));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + count), _mm256_permutevar8x32_epi32(values, order));
+				count += tables.counts[selected];
+			}
+		}
+		return count + compact_scalar(data + i, selection + i, size - i, out + count);
+	}
+
+#endif
+
+	// Copies the values of data[0, size) whose selection byte is 1 (the others must be 0) to out, in order, and
+	// returns how many there are
+	// o out needs room for size values, all of which may be written to
+	// o out may be data itself or lie before it, but must not overlap it otherwise
+	template <typename T>
+	std::size_t compact(T const* data, unsigned char const* selection, std::size_t size, T* out, std::true_type)
+	{
+#if LINQ_SIMD_X86
+		if (active_level() == avx2_level)
+			return compact_avx2(data, selection, size, out);
+#endif
+		return compact_scalar(data, selection, size, out);
+	}
+
+	template <typename T>
+	std::size_t compact(T const* data, unsigned char const* selection, std::size_t size, T* out, std::false_type)
+	{
+		return compact_scalar(data, selection, size, out);
+	}
+
+	template <typename T>
+	std::size_t compact(T const* data, unsigned char const* selection, std::size_t size, T* out)
+	{
+		return compact(data, selection, size, out, std::integral_constant<bool, sizeof(T) == 4 || sizeof(T) == 8>());
+	}
+
+	// The kernels for values of type T
+	// o has_sum: sum(data, size), pairwise (through sum_block) for floating point types, wrapping for integers
+	// o has_minmax: minmax_block(data, min, max, unordered) over block_size values; unordered is set if there is
+	//   a NaN among them, and min and max are then meaningless
+	template <typename T, typename Enable = void>
+	struct kernels
+	{
+		static const bool has_sum = false;
+		static const bool has_minmax = false;
+		static const bool is_pairwise = false;
+	};
+
+	template <typename T>
+	struct kernels<T, typename std::enable_if<std::is_same<T, float>::value || std::is_same<T, double>::value>::type>
+	{
+		static const bool has_sum = true;
+		static const bool has_minmax = true;
+		static const bool is_pairwise = true;
+
+		static T sum_block(T const* data)
+		{
+#if LINQ_SIMD_X86
+			if (active_level() == avx2_level)
+				return sum_block_avx2(data);
+			if (active_level() == sse2_level)
+				return sum_block_sse2(data);
+#endif
+			return sum_block_scalar(data);
+		}
+
+		static void minmax_block(T const* data, T& min, T& max, bool& unordered)
+		{
+#if LINQ_SIMD_X86
+			if (active_level() == avx2_level)
+				return minmax_block_avx2(data, min, max, unordered);
+			if (active_level() == sse2_level)
+				return minmax_block_sse2(data, min, max, unordered);
+#endif
+			minmax_block_scalar(data, min, max, unordered);
+		}
+	};
+
+	template <typename T>
+	struct kernels<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && (sizeof(T) == 4 || sizeof(T) == 8)>::type>
+	{
+		static const bool has_sum = true;
+		//unsigned comparisons would need a bias, and SSE2 has no 64 bit comparison at all
+		static const bool has_minmax = std::is_signed<T>::value;
+		static const bool is_pairwise = false;
+
+		static T sum(T const* data, std::size_t size)
+		{
+#if LINQ_SIMD_X86
+			if (active_level() == avx2_level)
+				return wrapping_sum_avx2(data, size);
+			if (active_level() == sse2_level)
+				return wrapping_sum_sse2(data, size);
+#endif
+			return wrapping_sum_scalar(data, size);
+		}
+
+		static void minmax_block(T const* data, T& min, T& max, bool& unordered)
+		{
+#if LINQ_SIMD_X86
+			if (active_level() == avx2_level)
+				return sizeof(T) == 4 ? minmax_block_avx2_int32(data, min, max, unordered) : minmax_block_avx2_int64(data, min, max, unordered);
+			if (active_level() == sse2_level && sizeof(T) == 4)
+				return minmax_block_sse2_int32(data, min, max, unordered);
+#endif
+			minmax_block_scalar(data, min, max, unordered);
+		}
+	};
+
+	// Accumulates a sum with the kernels, from arrays or value by value
+	template <typename T, bool IsPairwise = kernels<T>::is_pairwise>
+	class sum_accumulator
+	{
+	private:
+		T total;
+
+	public:
+		sum_accumulator()
+			: total(0)
+		{
+		}
+
+		void add(T const* data, std::size_t size)
+		{
+			T sums[2] = { total, kernels<T>::sum(data, size) };
+			total = wrapping_sum_scalar(sums, 2);
+		}
+
+		//wraps around like the kernels, without calling them for a single value
+		void add(T value)
+		{
+			typedef typename std::make_unsigned<T>::type unsigned_type;
+			total = static_cast<T>(static_cast<unsigned_type>(total) + static_cast<unsigned_type>(value));
+		}
+
+		T result() const
+		{
+			return total;
+		}
+	};
+
+	//blocks start every block_size values from the first, however the values arrive, so the result only depends on
+	//the sequence of values; levels[k] holds the sum of 2^k blocks, merged like the digits of a binary counter
+	template <typename T>
+	class sum_accumulator<T, true>
+	{
+	private:
+		T pending[block_size];
+		std::size_t pending_count;
+		T levels[64];
+		std::uint64_t block_count;
+
+		void add_block(T sum)
+		{
+			std::size_t level = 0;
+			for (std::uint64_t count = block_count; count & 1; count >>= 1, ++level)
+				sum = levels[level] + sum;
+			levels[level] = sum;
+			++block_count;
+		}
+
+	public:
+		sum_accumulator()
+			: pending_count(0)
+			, block_count(0)
+		{
+		}
+
+		void add(T const* data, std::size_t size)
+		{
+			while (pending_count != 0 && size != 0)
+			{
+				add(*data++);
+				--size;
+			}
+			for (; size >= block_size; data += block_size, size -= block_size)
+				add_block(kernels<T>::sum_block(data));
+			for (; size != 0; --size)
+				pending[pending_count++] = *data++;
+		}
+
+		void add(T value)
+		{
+			pending[pending_count++] = value;
+			if (pending_count == block_size)
+			{
+				add_block(kernels<T>::sum_block(pending));
+				pending_count = 0;
+			}
+		}
+
+		//the last, partial block is padded with zeros
+		T result() const
+		{
+			T total = 0;
+			if (pending_count != 0)
+			{
+				T last[block_size];
+				std::copy(pending, pending + pending_count, last);
+				std::fill(last + pending_count, last + block_size, T(0));
+				total = kernels<T>::sum_block(last);
+			}
+			std::size_t level = 0;
+			for (std::uint64_t count = block_count; count != 0; count >>= 1, ++level)
+			{
+				if (count & 1)
+					total = levels[level] + total;
+			}
+			return total;
+		}
+	};
+
+	template <typename T>
+	void fold_minmax_scalar(T const* data, std::size_t size, T const*& min, T const*& max)
+	{
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			if (data[i] < *min)
+				min = data + i;
+			if (*max < data[i])
+				max = data + i;
+		}
+	}
+
+	// Folds data[0, size) into min and max, the first least and the first greatest value so far (which may lie
+	// outside data), exactly as comparing value by value with < would
+	// o Whole blocks are reduced with the kernel and only searched for the first position of a new extreme;
+	//   blocks with a NaN are compared value by value
+	template <typename T>
+	void fold_minmax(T const* data, std::size_t size, T const*& min, T const*& max)
+	{
+		std::size_t i = 0;
+		for (; i + block_size <= size; i += block_size)
+		{
+			T block_min, block_max;
+			bool unordered;
+			kernels<T>::minmax_block(data + i, block_min, block_max, unordered);
+			if (unordered)
+			{
+				fold_minmax_scalar(data + i, block_size, min, max);
+				continue;
+			}
+			if (block_min < *min)
+				min = std::find(data + i, data + i + block_size, block_min);
+			if (*max < block_max)
+				max = std::find(data + i, data + i + block_size, block_max);
+		}
+		fold_minmax_scalar(data + i, size - i, min, max);
+	}
+
+}
+
+}
\ No newline at end of file
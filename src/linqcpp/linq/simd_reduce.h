@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "batch_traits.h"
+#include "random_access_traits.h"
+#include "contiguous_traits.h"
+#include "push_traits.h"
+#include "simd_kernels.h"
+
+// How interactive's sum, min, max, minmax and count_if reach the kernels of simd_kernels.h
+// o simd_contiguous_path: contiguous enumerators (e.g. from over a std::vector) are reduced in place
+// o simd_batched_path: other batched enumerators (e.g. a simple select over a contiguous source) a batch at a time;
+//   for min/max/minmax only if they yield values, as references into a batch would not outlive it
+// o simd_scalar_path: value by value; sums of floating point values are still accumulated pairwise
+
+namespace linq {
+
+struct simd_scalar_path
+{
+};
+
+struct simd_batched_path
+{
+};
+
+struct simd_contiguous_path
+{
+};
+
+template <typename Enumerator>
+struct simd_reduce_traits
+{
+	typedef typename std::decay<typename Enumerator::value_type>::type element_type;
+
+private:
+	static const bool is_contiguous = contiguous_traits<Enumerator>::is_contiguous;
+	static const bool is_batched = batch_traits<Enumerator>::is_batched;
+
+public:
+	typedef typename std::conditional<is_contiguous && simd::kernels<element_type>::has_sum, simd_contiguous_path,
+		typename std::conditional<is_batched && simd::kernels<element_type>::has_sum, simd_batched_path,
+		simd_scalar_path>::type>::type sum_path;
+
+	typedef typename std::conditional<is_contiguous && simd::kernels<element_type>::has_minmax, simd_contiguous_path,
+		typename std::conditional<is_batched && simd::kernels<element_type>::has_minmax && !std::is_reference<typename Enumerator::value_type>::value, simd_batched_path,
+		simd_scalar_path>::type>::type minmax_path;
+};
+
+//only for element types with simd::kernels<T>::has_sum
+template <typename Enumerable>
+typename simd_reduce_traits<typename Enumerable::enumerator_type>::element_type simd_sum(Enumerable& source, simd_contiguous_path)
+{
+	typedef typename simd_reduce_traits<typename Enumerable::enumerator_type>::element_type element_type;
+	auto e = source.get_enumerator();
+	simd::sum_accumulator<element_type> sum;
+	if (e.size() != 0)
+		sum.add(&e.at(0), e.size());
+	return sum.result();
+}
+
+template <typename Enumerable>
+typename simd_reduce_traits<typename Enumerable::enumerator_type>::element_type simd_sum(Enumerable& source, simd_batched_path)
+{
+	typedef typename simd_reduce_traits<typename Enumerable::enumerator_type>::element_type element_type;
+	static const std::size_t capacity = batch_capacity<element_type>::value;
+	element_type buffer[capacity];
+
+	auto e = source.get_enumerator();
+	simd::sum_accumulator<element_type> sum;
+	while (true)
+	{
+		std::size_t count = e.next_batch(buffer, capacity);
+		sum.add(buffer, count);
+		if (count < capacity)
+			return sum.result();
+	}
+}
+
+template <typename Enumerable>
+typename simd_reduce_traits<typename Enumerable::enumerator_type>::element_type simd_sum(Enumerable& source, simd_scalar_path)
+{
+	typedef typename simd_reduce_traits<typename Enumerable::enumerator_type>::element_type element_type;
+	typedef typename Enumerable::value_type value_type;
+	simd::sum_accumulator<element_type> sum;
+	auto sink = [&](value_type value) -> bool
+	{
+		sum.add(value);
+		return true;
+	};
+	linq::push(source, sink);
+	return sum.result();
+}
+
+//the positions of the first least and the first greatest value of a fresh contiguous enumerator with size() != 0
+template <typename Enumerator>
+std::pair<std::size_t, std::size_t> simd_minmax_positions(Enumerator& e)
+{
+	typedef typename simd_reduce_traits<Enumerator>::element_type element_type;
+	element_type const* data = &e.at(0);
+	element_type const* min = data;
+	element_type const* max = data;
+	simd::fold_minmax(data + 1, e.size() - 1, min, max);
+	return std::make_pair(static_cast<std::size_t>(min - data), static_cast<std::size_t>(max - data));
+}
+
+//the first least and the first greatest value of a batched enumerable; throws like move_first_or_throw if it is empty
+template <typename Enumerable>
+std::pair<typename Enumerable::value_type, typename Enumerable::value_type> simd_minmax_values(Enumerable& source)
+{
+	typedef typename simd_reduce_traits<typename Enumerable::enumerator_type>::element_type element_type;
+	static const std::size_t capacity = batch_capacity<element_type>::value;
+	element_type buffer[capacity];
+
+	auto e = source.get_enumerator();
+	std::size_t count = e.next_batch(buffer, capacity);
+	if (count == 0)
+		throw new std::logic_error("move_first returned false");
+	element_type min_value = buffer[0];
+	element_type max_value = buffer[0];
+	std::size_t first = 1;
+	while (true)
+	{
+		element_type const* min = &min_value;
+		element_type const* max = &max_value;
+		simd::fold_minmax(buffer + first, count - first, min, max);
+		min_value = *min;
+		max_value = *max;
+		if (count < capacity)
+			return std::make_pair(min_value, max_value);
+		count = e.next_batch(buffer, capacity);
+		first = 0;
+	}
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Optional extension of concept Enumerable<T>: size hints
+// o size_hint get_size_hint()
+//   o Describes how many values get_enumerator() will produce, without enumerating
+//   o exact: exactly size values
+//   o at_most: no more than size values
+//   o unknown: nothing is known (the sequence may be infinite)
+// o Enumerables without get_size_hint are treated as unknown
+
+namespace linq {
+
+class size_hint
+{
+public:
+	enum kind_type
+	{
+		unknown_kind,
+		at_most_kind,
+		exact_kind
+	};
+
+private:
+	kind_type _kind;
+	std::size_t _size;
+
+	size_hint(kind_type kind, std::size_t size)
+		: _kind(kind)
+		, _size(size)
+	{
+	}
+
+public:
+	static size_hint unknown()
+	{
+		return size_hint(unknown_kind, 0);
+	}
+
+	static size_hint at_most(std::size_t size)
+	{
+		return size_hint(at_most_kind, size);
+	}
+
+	static size_hint exact(std::size_t size)
+	{
+		return size_hint(exact_kind, size);
+	}
+
+	kind_type kind() const
+	{
+		return _kind;
+	}
+
+	bool is_exact() const
+	{
+		return _kind == exact_kind;
+	}
+
+	bool is_bounded() const
+	{
+		return _kind != unknown_kind;
+	}
+
+	//only meaningful if is_bounded()
+	std::size_t size() const
+	{
+		return _size;
+	}
+
+	//the same bound, but no longer exact (e.g. after filtering)
+	size_hint loosen() const
+	{
+		return is_bounded() ? at_most(_size) : unknown();
+	}
+
+	//the hint for the first "count" values of this sequence
+	size_hint take(std::size_t count) const
+	{
+		if (!is_bounded())
+			return at_most(count);
+		return size_hint(_kind, _size < count ? _size : count);
+	}
+
+	//the hint for this sequence without its first "count" values
+	size_hint skip(std::size_t count) const
+	{
+		if (!is_bounded())
+			return unknown();
+		return size_hint(_kind, _size < count ? 0 : _size - count);
+	}
+
+	//the hint for the values of this sequence followed by the values of other
+	size_hint plus(size_hint const& other) const
+	{
+		if (!is_bounded() || !other.is_bounded())
+			return unknown();
+		return size_hint(is_exact() && other.is_exact() ? exact_kind : at_most_kind, _size + other._size);
+	}
+};
+
+namespace detail {
+
+	template <typename Enumerable>
+	auto get_size_hint(Enumerable& enumerable, int) -> decltype(enumerable.get_size_hint())
+	{
+		return enumerable.get_size_hint();
+	}
+
+	template <typename Enumerable>
+	size_hint get_size_hint(Enumerable&, long)
+	{
+		return size_hint::unknown();
+	}
+
+}
+
+template <typename Enumerable>
+size_hint get_size_hint(Enumerable& enumerable)
+{
+	return detail::get_size_hint(enumerable, 0);
+}
+
+}
@@ -1,13 +1,19 @@
 #pragma once
 
-#include "make_unique.h"
+#include <type_traits>
+
 #include "enumerable.h"
+#include "size_hint.h"
+#include "prefix_hint.h"
+#include "push_traits.h"
+#include "counter_predicate.h"
+#include "random_access_traits.h"
 #include "skip_while_enumerator.h"
 
 namespace linq {
 
 template <typename Source, typename Predicate>
-class skip_while_enumerable : public enumerable<typename Source::value_type>
+class skip_while_enumerable
 {
 public:
 	typedef skip_while_enumerator<typename Source::enumerator_type, Predicate> enumerator_type;
@@ -20,6 +26,52 @@ private:
 	skip_while_enumerable(skip_while_enumerable const&); // not defined
 	skip_while_enumerable& operator=(skip_while_enumerable const&); // not defined
 	
+	template <typename OtherPredicate>
+	size_hint get_size_hint(OtherPredicate const&)
+	{
+		return linq::get_size_hint(source).loosen();
+	}
+
+	size_hint get_size_hint(counter_predicate<value_type> const& counter)
+	{
+		return linq::get_size_hint(source).skip(counter.get_remaining());
+	}
+
+	template <typename OtherPredicate>
+	void set_prefix_hint(std::size_t, OtherPredicate const&)
+	{
+	}
+
+	void set_prefix_hint(std::size_t count, counter_predicate<value_type> const& counter)
+	{
+		linq::set_prefix_hint(source, saturating_add(count, counter.get_remaining()));
+	}
+	
+	//skip(count) over a random access source jumps in the enumerator, so drive that instead
+	template <typename Sink>
+	bool push(Sink& sink, std::true_type)
+	{
+		return push_lookup::push(*this, sink, 0L);
+	}
+
+	template <typename Sink>
+	bool push(Sink& sink, std::false_type)
+	{
+		Predicate predicate = this->predicate;
+		bool skipping = true;
+		auto skip_while_sink = [&](value_type value) -> bool
+		{
+			if (skipping)
+			{
+				if (predicate(value))
+					return true;
+				skipping = false;
+			}
+			return sink(std::forward<value_type>(value));
+		};
+		return linq::push(source, skip_while_sink);
+	}
+
 public:
 	skip_while_enumerable(skip_while_enumerable&& other)
 		: source(std::move(other.source))
@@ -38,9 +90,20 @@ public:
 		return enumerator_type(std::move(source.get_enumerator()), predicate);
 	}
 
-	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
+	size_hint get_size_hint()
+	{
+		return get_size_hint(predicate);
+	}
+
+	void set_prefix_hint(std::size_t count)
+	{
+		set_prefix_hint(count, predicate);
+	}
+
+	template <typename Sink>
+	bool push(Sink& sink)
 	{
-		return make_unique<enumerator_type>(std::move(get_enumerator()));
+		return push(sink, std::integral_constant<bool, random_access_traits<enumerator_type>::is_random_access>());
 	}
 };
 
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <type_traits>
+
 #include "enumerator.h"
+#include "random_access_traits.h"
+#include "counter_predicate.h"
 
 namespace linq {
 
 template <typename Source, typename Predicate>
-class skip_while_enumerator : public enumerator<typename Source::value_type>
+class skip_while_enumerator
 {
 public:
 	typedef typename Source::value_type value_type;
@@ -17,20 +21,22 @@ private:
 	skip_while_enumerator(skip_while_enumerator const&); // not defined
 	skip_while_enumerator& operator=(skip_while_enumerator const&); // not defined
 
-public:
-	skip_while_enumerator(skip_while_enumerator&& other)
-		: source(std::move(other.source))
-		, predicate(std::move(other.predicate))
+	//skip(count) over a random access source jumps instead of testing each skipped value
+	void skip_counted()
 	{
+		std::size_t available = source.size();
+		std::size_t remaining = predicate.get_remaining();
+		source.advance(remaining < available ? remaining : available);
+		predicate = Predicate(0);
 	}
 
-	skip_while_enumerator(Source&& source, Predicate const& predicate)
-		: source(std::move(source))
-		, predicate(predicate)
+	bool move_first(std::true_type)
 	{
+		skip_counted();
+		return source.move_first();
 	}
 
-	bool move_first()
+	bool move_first(std::false_type)
 	{
 		if (!source.move_first())
 		{
@@ -45,6 +51,24 @@ public:
 
 		return true;
 	}
+
+public:
+	skip_while_enumerator(skip_while_enumerator&& other)
+		: source(std::move(other.source))
+		, predicate(std::move(other.predicate))
+	{
+	}
+
+	skip_while_enumerator(Source&& source, Predicate const& predicate)
+		: source(std::move(source))
+		, predicate(predicate)
+	{
+	}
+
+	bool move_first()
+	{
+		return move_first(std::integral_constant<bool, random_access_traits<skip_while_enumerator>::is_random_access>());
+	}
 	
 	bool move_next()
 	{
@@ -55,6 +79,31 @@ public:
 	{
 		return source.current();
 	}
+
+	//random access is only available for skip(count), i.e. Predicate == counter_predicate
+	std::size_t size()
+	{
+		skip_counted();
+		return source.size();
+	}
+
+	void advance(std::size_t count)
+	{
+		skip_counted();
+		source.advance(count);
+	}
+
+	value_type at(std::size_t index)
+	{
+		skip_counted();
+		return source.at(index);
+	}
+};
+
+template <typename Source>
+struct random_access_traits<skip_while_enumerator<Source, counter_predicate<typename Source::value_type>>>
+{
+	static const bool is_random_access = random_access_traits<Source>::is_random_access;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+// Optional extension of the Compare used by order_by_enumerator: sort keys
+// o typedef ... key_type, whose operator< orders keys exactly as Compare orders the values they came from
+// o key_type key(value_type const& value)
+// o Lets order_by_enumerator extract each value's key once and sort the keys instead of the values
+// o The comparers built by order_by and then_by provide it; other comparers are used as they are
+
+namespace linq {
+
+namespace sort_key_lookup {
+
+	template <typename Compare>
+	auto key_type(int) -> typename Compare::key_type;
+
+	template <typename Compare>
+	void key_type(long);
+
+}
+
+template <typename Compare>
+struct sort_key_traits
+{
+	//void if Compare does not provide keys
+	typedef decltype(sort_key_lookup::key_type<Compare>(0)) key_type;
+
+	static const bool has_key = !std::is_void<key_type>::value;
+};
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+#include "memory_resource.h"
+
+namespace linq {
+
+class thread_pool;
+
+// How order_by_enumerator sorts its buffered values
+// o pool: if set, buffers of at least parallel_threshold values are sorted on it
+// o normalize_keys: if the keys allow it, they are compared as memcmp-ordered byte strings (see normalized_key.h)
+// o memory_budget: bytes (counted as sizeof(value_type) per value) buffered before a sorted run is spilled to a
+//   temporary file; runs are merged while enumerating (see external_sort.h)
+// o skip: the first skip values of the ordering are left out (see drop_prefix in prefix_hint.h)
+// o prefix: only the first prefix values of the ordering after those will be enumerated (see prefix_hint.h)
+// o resource: where the buffered values and sort entries are allocated (the global heap by default)
+// o Every policy produces the same (stable) order
+struct sort_policy
+{
+	thread_pool* pool;
+	std::size_t parallel_threshold;
+	bool normalize_keys;
+	std::size_t memory_budget;
+	std::size_t skip;
+	std::size_t prefix;
+	memory_resource* resource;
+
+	sort_policy()
+		: pool(nullptr)
+		, parallel_threshold(1 << 16)
+		, normalize_keys(false)
+		, memory_budget(std::numeric_limits<std::size_t>::max())
+		, skip(0)
+		, prefix(std::numeric_limits<std::size_t>::max())
+		, resource(new_delete_resource())
+	{
+	}
+};
+
+}
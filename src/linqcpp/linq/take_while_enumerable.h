@@ -1,13 +1,16 @@
 #pragma once
 
-#include "make_unique.h"
 #include "enumerable.h"
+#include "size_hint.h"
+#include "prefix_hint.h"
+#include "push_traits.h"
+#include "counter_predicate.h"
 #include "take_while_enumerator.h"
 
 namespace linq {
 
 template <typename Source, typename Predicate>
-class take_while_enumerable : public enumerable<typename Source::value_type>
+class take_while_enumerable
 {
 public:
 	typedef take_while_enumerator<typename Source::enumerator_type, Predicate> enumerator_type;
@@ -20,6 +23,28 @@ private:
 	take_while_enumerable(take_while_enumerable const&); // not defined
 	take_while_enumerable& operator=(take_while_enumerable const&); // not defined
 	
+	template <typename OtherPredicate>
+	size_hint get_size_hint(OtherPredicate const&)
+	{
+		return linq::get_size_hint(source).loosen();
+	}
+
+	size_hint get_size_hint(counter_predicate<value_type> const& counter)
+	{
+		return linq::get_size_hint(source).take(counter.get_remaining());
+	}
+
+	template <typename OtherPredicate>
+	void set_prefix_hint(std::size_t count, OtherPredicate const&)
+	{
+		linq::set_prefix_hint(source, count);
+	}
+
+	void set_prefix_hint(std::size_t count, counter_predicate<value_type> const& counter)
+	{
+		linq::set_prefix_hint(source, count < counter.get_remaining() ? count : counter.get_remaining());
+	}
+	
 public:
 	take_while_enumerable(take_while_enumerable&& other)
 		: source(std::move(other.source))
@@ -38,9 +63,30 @@ public:
 		return enumerator_type(std::move(source.get_enumerator()), predicate);
 	}
 
-	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
+	size_hint get_size_hint()
+	{
+		return get_size_hint(predicate);
+	}
+
+	void set_prefix_hint(std::size_t count)
+	{
+		set_prefix_hint(count, predicate);
+	}
+
+	template <typename Sink>
+	bool push(Sink& sink)
 	{
-		return make_unique<enumerator_type>(std::move(get_enumerator()));
+		Predicate predicate = this->predicate;
+		bool stopped = false;
+		auto take_while_sink = [&](value_type value) -> bool
+		{
+			if (!predicate(value))
+				return false;
+			stopped = !sink(std::forward<value_type>(value));
+			return !stopped;
+		};
+		linq::push(source, take_while_sink);
+		return !stopped;
 	}
 };
 
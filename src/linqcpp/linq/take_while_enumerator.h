@@ -1,11 +1,13 @@
 #pragma once
 
 #include "enumerator.h"
+#include "random_access_traits.h"
+#include "counter_predicate.h"
 
 namespace linq {
 
 template <typename Source, typename Predicate>
-class take_while_enumerator : public enumerator<typename Source::value_type>
+class take_while_enumerator
 {
 public:
 	typedef typename Source::value_type value_type;
@@ -44,6 +46,31 @@ public:
 	{
 		return source.current();
 	}
+
+	//random access is only available for take(count), i.e. Predicate == counter_predicate
+	std::size_t size()
+	{
+		std::size_t available = source.size();
+		std::size_t remaining = predicate.get_remaining();
+		return remaining < available ? remaining : available;
+	}
+
+	void advance(std::size_t count)
+	{
+		source.advance(count);
+		predicate = Predicate(predicate.get_remaining() - count);
+	}
+
+	value_type at(std::size_t index)
+	{
+		return source.at(index);
+	}
+};
+
+template <typename Source>
+struct random_access_traits<take_while_enumerator<Source, counter_predicate<typename Source::value_type>>>
+{
+	static const bool is_random_access = random_access_traits<Source>::is_random_access;
 };
 
 }
\ No newline at end of file
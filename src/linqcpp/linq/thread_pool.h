@@ -0,0 +1,298 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define LINQ_THREAD_LOCAL __declspec(thread)
+#else
+#define LINQ_THREAD_LOCAL thread_local
+#endif
+
+namespace linq {
+
+// A pool of worker threads, each with its own deque of tasks
+// o Workers pop their own newest task first and steal the oldest task of another worker when idle
+// o Tasks submitted from outside the pool are dealt round robin across the workers
+// o Destruction (or shutdown) runs every task already submitted, then joins the workers
+// o A single pool can be shared by every query (and the rest of an application) to avoid oversubscription
+class thread_pool
+{
+private:
+	typedef std::function<void ()> task_type;
+
+	struct worker_queue
+	{
+		std::mutex mutex;
+		std::deque<task_type> tasks;
+	};
+
+	std::vector<std::unique_ptr<worker_queue>> queues;
+	std::vector<std::thread> workers;
+	std::atomic<std::size_t> next_queue;
+	std::atomic<std::size_t> queued_count;
+	std::mutex idle_mutex;
+	std::condition_variable idle_condition;
+	bool stopping;
+
+	thread_pool(thread_pool const&); // not defined
+	thread_pool& operator=(thread_pool const&); // not defined
+
+	struct worker_identity
+	{
+		thread_pool* pool;
+		std::size_t index;
+	};
+
+	static worker_identity& current_worker()
+	{
+		static LINQ_THREAD_LOCAL worker_identity identity = { nullptr, 0 };
+		return identity;
+	}
+
+	bool try_pop(std::size_t index, task_type& task)
+	{
+		worker_queue& queue = *queues[index];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.tasks.empty())
+			return false;
+		task = std::move(queue.tasks.back());
+		queue.tasks.pop_back();
+		--queued_count;
+		return true;
+	}
+
+	bool try_steal(std::size_t index, task_type& task)
+	{
+		worker_queue& queue = *queues[index];
+		std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+		if (!lock.owns_lock() || queue.tasks.empty())
+			return false;
+		task = std::move(queue.tasks.front());
+		queue.tasks.pop_front();
+		--queued_count;
+		return true;
+	}
+
+	//pops from the given worker's own deque, then steals from the others
+	bool try_take(std::size_t index, task_type& task)
+	{
+		if (try_pop(index, task))
+			return true;
+		for (std::size_t i = 1; i < queues.size(); ++i)
+		{
+			if (try_steal((index + i) % queues.size(), task))
+				return true;
+		}
+		return false;
+	}
+
+	void work(std::size_t index)
+	{
+		current_worker().pool = this;
+		current_worker().index = index;
+		task_type task;
+		while (true)
+		{
+			if (try_take(index, task))
+			{
+				task();
+				task = nullptr;
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(idle_mutex);
+			if (queued_count == 0 && stopping)
+				return;
+			idle_condition.wait(lock, [this](){ return queued_count > 0 || stopping; });
+		}
+	}
+
+public:
+	explicit thread_pool(std::size_t worker_count = std::thread::hardware_concurrency())
+		: next_queue(0)
+		, queued_count(0)
+		, stopping(false)
+	{
+		if (worker_count == 0)
+			worker_count = 1;
+		for (std::size_t i = 0; i < worker_count; ++i)
+			queues.push_back(std::unique_ptr<worker_queue>(new worker_queue()));
+		for (std::size_t i = 0; i < worker_count; ++i)
+			workers.push_back(std::thread([this, i](){ work(i); }));
+	}
+
+	~thread_pool()
+	{
+		shutdown();
+	}
+
+	//the pool used by the parallel operators unless they are given one
+	static thread_pool& default_pool()
+	{
+		static thread_pool pool;
+		return pool;
+	}
+
+	std::size_t worker_count() const
+	{
+		return queues.size();
+	}
+
+	//true if the calling thread is one of this pool's workers
+	bool is_worker() const
+	{
+		return current_worker().pool == this;
+	}
+
+	//runs task on some worker; submissions from a worker go to its own deque
+	//once shutdown has begun only workers (running the tasks being drained) may submit; anyone else gets a std::logic_error
+	void submit(task_type task)
+	{
+		bool from_worker = is_worker();
+		std::size_t index = from_worker
+			? current_worker().index
+			: next_queue++ % queues.size();
+		{
+			//held while the task is queued, so workers cannot see an empty pool and exit in between
+			std::lock_guard<std::mutex> idle_lock(idle_mutex);
+			if (stopping && !from_worker)
+				throw new std::logic_error("submit called on a thread_pool that is shut down");
+			worker_queue& queue = *queues[index];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.tasks.push_back(std::move(task));
+			++queued_count;
+		}
+		idle_condition.notify_one();
+	}
+
+	//runs one queued task on the calling thread, if there is one (used to help while waiting)
+	bool run_pending_task()
+	{
+		task_type task;
+		std::size_t index = is_worker() ? current_worker().index : 0;
+		if (!try_take(index, task))
+			return false;
+		task();
+		return true;
+	}
+
+	//runs every task already submitted, then joins the workers; idempotent
+	void shutdown()
+	{
+		{
+			std::lock_guard<std::mutex> lock(idle_mutex);
+			if (stopping)
+				return;
+			stopping = true;
+		}
+		idle_condition.notify_all();
+		for (auto worker = workers.begin(); worker != workers.end(); ++worker)
+			worker->join();
+	}
+};
+
+// Fork/join: run() forks tasks onto a thread_pool and wait() joins them all
+// o wait() runs queued tasks on the calling thread rather than blocking, so groups can nest
+// o The first exception thrown by a task is rethrown by wait()
+class task_group
+{
+private:
+	thread_pool& pool;
+	std::atomic<std::size_t> pending;
+	std::mutex mutex;
+	std::condition_variable done;
+	std::exception_ptr error;
+
+	task_group(task_group const&); // not defined
+	task_group& operator=(task_group const&); // not defined
+
+	void finish()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (--pending == 0)
+			done.notify_all();
+	}
+
+public:
+	explicit task_group(thread_pool& pool = thread_pool::default_pool())
+		: pool(pool)
+		, pending(0)
+	{
+	}
+
+	~task_group()
+	{
+		try
+		{
+			wait();
+		}
+		catch (...)
+		{
+		}
+	}
+
+	thread_pool& get_pool()
+	{
+		return pool;
+	}
+
+	//if the pool rejects the task (e.g. it is shut down), the exception propagates and the task no longer counts as pending
+	template <typename Task>
+	void run(Task task)
+	{
+		++pending;
+		try
+		{
+			pool.submit([this, task]()
+			{
+				try
+				{
+					task();
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					if (!error)
+						error = std::current_exception();
+				}
+				finish();
+			});
+		}
+		catch (...)
+		{
+			finish();
+			throw;
+		}
+	}
+
+	void wait()
+	{
+		while (pending != 0)
+		{
+			if (pool.run_pending_task())
+				continue;
+			std::unique_lock<std::mutex> lock(mutex);
+			done.wait_for(lock, std::chrono::milliseconds(1), [this](){ return pending == 0; });
+		}
+		std::exception_ptr e;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			std::swap(e, error);
+		}
+		if (e)
+			std::rethrow_exception(e);
+	}
+};
+
+}
@@ -1,13 +1,15 @@
 #pragma once
 
-#include "make_unique.h"
 #include "enumerable.h"
+#include "size_hint.h"
+#include "push_traits.h"
+#include "partition_traits.h"
 #include "where_enumerator.h"
 
 namespace linq {
 
 template <typename Source, typename Predicate>
-class where_enumerable : public enumerable<typename Source::value_type>
+class where_enumerable
 {
 public:
 	typedef where_enumerator<typename Source::enumerator_type, Predicate> enumerator_type;
@@ -38,10 +40,39 @@ public:
 		return enumerator_type(std::move(source.get_enumerator()), predicate);
 	}
 
-	std::unique_ptr<enumerator<value_type>> get_enumerator_ptr()
+	std::size_t partition_size()
 	{
-		return make_unique<enumerator_type>(std::move(get_enumerator()));
+		return source.partition_size();
 	}
+
+	enumerator_type get_partition(std::size_t first, std::size_t last)
+	{
+		return enumerator_type(std::move(source.get_partition(first, last)), predicate);
+	}
+
+	size_hint get_size_hint()
+	{
+		return linq::get_size_hint(source).loosen();
+	}
+
+	template <typename Sink>
+	bool push(Sink& sink)
+	{
+		Predicate predicate = this->predicate;
+		auto where_sink = [&](value_type value) -> bool
+		{
+			if (!predicate(value))
+				return true;
+			return sink(std::forward<value_type>(value));
+		};
+		return linq::push(source, where_sink);
+	}
+};
+
+template <typename Source, typename Predicate>
+struct partition_traits<where_enumerable<Source, Predicate>>
+{
+	static const bool is_partitionable = partition_traits<Source>::is_partitionable;
 };
 
 }
\ No newline at end of file
@@ -1,11 +1,18 @@
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+
 #include "enumerator.h"
+#include "batch_traits.h"
+#include "contiguous_traits.h"
+#include "expression.h"
+#include "simd_kernels.h"
 
 namespace linq {
 
 template <typename Source, typename Predicate>
-class where_enumerator : public enumerator<typename Source::value_type>
+class where_enumerator
 {
 public:
 	typedef typename Source::value_type value_type;
@@ -69,6 +76,92 @@ public:
 	{
 		return source.current();
 	}
+
+private:
+	typedef typename batch_traits<where_enumerator>::batch_type batch_type;
+
+	//a block evaluable predicate (see expression.h) writes its selection bytes itself
+	void evaluate(batch_type const* data, std::size_t size, unsigned char* selection, std::true_type)
+	{
+		predicate.evaluate(data, size, selection);
+	}
+
+	void evaluate(batch_type const* data, std::size_t size, unsigned char* selection, std::false_type)
+	{
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			selection[i] = predicate(data[i]) ? 1 : 0;
+		}
+	}
+
+	//copies the values of data[0, size) the predicate holds for to out (which may be data), without branching on the
+	//predicate: it is evaluated over a block into selection bytes, and the block compacted by simd::compact
+	std::size_t select(batch_type const* data, std::size_t size, batch_type* out)
+	{
+		typedef block_evaluation_traits<Predicate, batch_type> evaluation_traits;
+		typedef std::integral_constant<bool, evaluation_traits::is_block_evaluable && std::is_same<typename evaluation_traits::result_type, bool>::value> is_block_evaluable;
+
+		unsigned char selection[simd::block_size];
+		std::size_t count = 0;
+		for (std::size_t first = 0; first < size; first += simd::block_size)
+		{
+			std::size_t block = std::min(simd::block_size, size - first);
+			evaluate(data + first, block, selection, is_block_evaluable());
+			count += simd::compact(data + first, selection, block, out + count);
+		}
+		return count;
+	}
+
+	//filter the source's storage straight into the output buffer
+	std::size_t next_batch(batch_type* buffer, std::size_t capacity, std::true_type)
+	{
+		std::size_t count = 0;
+		while (count < capacity)
+		{
+			std::size_t available = source.size();
+			if (available == 0)
+			{
+				break;
+			}
+			std::size_t block = std::min(capacity - count, available);
+			count += select(&source.at(0), block, buffer + count);
+			source.advance(block);
+		}
+		return count;
+	}
+
+	//pull straight into the output buffer and compact the survivors in place
+	std::size_t next_batch(batch_type* buffer, std::size_t capacity, std::false_type)
+	{
+		std::size_t count = 0;
+		while (count < capacity)
+		{
+			std::size_t requested = capacity - count;
+			std::size_t received = source.next_batch(buffer + count, requested);
+			count += select(buffer + count, received, buffer + count);
+			if (received < requested)
+			{
+				break;
+			}
+		}
+		return count;
+	}
+
+public:
+	std::size_t next_batch(typename batch_traits<where_enumerator>::batch_type* buffer, std::size_t capacity)
+	{
+		return next_batch(buffer, capacity, std::integral_constant<bool, contiguous_traits<Source>::is_contiguous>());
+	}
+};
+
+//batched only when the predicate cannot observe that it is handed a buffered copy instead of the source value
+template <typename Source, typename Predicate>
+struct batch_traits<where_enumerator<Source, Predicate>>
+{
+	typedef typename batch_traits<Source>::batch_type batch_type;
+	static const bool is_batched =
+		batch_traits<Source>::is_batched &&
+		is_batch_callable<Predicate, batch_type const&>::value;
 };
 
 }
\ No newline at end of file